@@ -0,0 +1,534 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Bench.cpp
+// Application: Shape File Compiler
+// Purpose:     Benchmark of the compiler stages
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <vector>
+
+#include "core/Core.h"
+
+#include "Compiler.h"
+#include "AtomicFile.h"
+#include "FontGenerator.h"
+#include "GlyphCache.h"
+#include "Interpreter.h"
+#include "ShpReader.h"
+#include "ShxDecompiler.h"
+#include "ShxFont.h"
+#include "ShxImage.h"
+#include "SpecLexer.h"
+#include "TextLayout.h"
+#include "ThreadPool.h"
+
+/*!
+ \brief Number of memory allocations of the process. Only the benchmark replaces the global
+ operator new, the compiler itself does not count.
+ */
+static std::atomic<uint64> allocations(0);
+
+void* operator new(size_t size)
+{
+	allocations++;
+	void* p = std::malloc(size > 0 ? size : 1);
+	if(p == nullptr)throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+typedef std::chrono::steady_clock Clock;
+
+/*!
+ \brief Number of failed checks, i.e. round trips through the decompiler and fonts compiled with
+ options, whose geometry differs.
+ */
+static uint32 failures = 0;
+
+/*!
+ \brief The measurements of one stage.
+ */
+struct Stage
+{
+	// Name of the stage.
+	const char* name;
+
+	// Duration of each run in seconds.
+	std::vector<double> seconds;
+
+	// Allocations of all runs.
+	uint64 allocations;
+
+	Stage(const char* name)
+	{
+		this->name = name;
+		allocations = 0;
+	}
+};
+
+/*!
+ \brief Returns the percentile of the sorted durations.
+ */
+static double percentile(const std::vector<double> &sorted, double p)
+{
+	if(sorted.empty())return 0;
+	size_t index = (size_t)(p * (sorted.size() - 1) + 0.5);
+	return sorted[index];
+}
+
+/*!
+ \brief Prints one line of the result table. The throughput refers to the median.
+ */
+static void print(const Stage &stage, size_t bytes, uint32 glyphs)
+{
+	std::vector<double> sorted = stage.seconds;
+	std::sort(sorted.begin(), sorted.end());
+	double median = percentile(sorted, 0.5);
+	if(median <= 0)median = 1e-9;
+
+	std::cout << std::left << std::setw(12) << stage.name << std::right << std::fixed
+	          << std::setprecision(1) << std::setw(10) << bytes / median / (1024 * 1024)
+	          << std::setprecision(0) << std::setw(12) << glyphs / median
+	          << std::setprecision(3) << std::setw(10) << percentile(sorted, 0.5) * 1000
+	          << std::setw(10) << percentile(sorted, 0.9) * 1000
+	          << std::setw(10) << percentile(sorted, 0.99) * 1000
+	          << std::setw(12) << stage.allocations / std::max<size_t>(stage.seconds.size(), 1)
+	          << std::endl;
+}
+
+/*!
+ \brief Splits the file into lines.
+ */
+static uint32 runReader(const std::string &shp)
+{
+	shpc::ShpReader reader;
+	reader.load((const uint8*)shp.data(), shp.size());
+
+	uint32 lines = 0;
+	shpc::ShpLine line;
+	while(reader.nextLine(line))lines++;
+	return lines;
+}
+
+/*!
+ \brief Splits the spec byte lines into tokens and converts them like the compiler.
+ */
+static uint32 runLexer(const std::string &shp)
+{
+	shpc::ShpReader reader;
+	reader.load((const uint8*)shp.data(), shp.size());
+
+	uint32 sum = 0;
+	shpc::ShpLine line;
+	while(reader.nextLine(line))
+	{
+		if(line.codeLength == 0 || line.data[0] == '*')continue;
+
+		shpc::SpecLexer lexer(line.data, line.codeLength, ",()");
+		shpc::Token token;
+		while(lexer.next(token))
+		{
+			token = shpc::trim(token);
+			if(token.length == 0)continue;
+			if(token.length > 4)sum += shpc::toSpecShort(token);
+			else sum += shpc::toSpecByte(token);
+		}
+	}
+	return sum;
+}
+
+/*!
+ \brief Lays out strings of random shapes of the compiled font with the glyph cache warmed up and
+ prints the strings per second.
+ */
+static void runLayout(const shpc::Compiler &compiler, uint32 runs, uint32 seed)
+{
+	const uint32 kStrings = 10000;
+	const uint32 kLength = 16;
+
+	const shpc::ShapeTable &shapes = compiler.shapes();
+	std::vector<uint16> text(kStrings * kLength);
+	uint32 random = seed;
+	for(size_t a = 0; a < text.size(); a++)
+	{
+		random = random * 1103515245 + 12345;
+		text[a] = shapes.number((random >> 8) % shapes.size());
+	}
+
+	shpc::GlyphCache cache(shapes, shpc::wideSubshapes(compiler.format()));
+	cache.prepare();
+	shpc::TextLayout layout(cache);
+	shpc::Outline outline;
+	shpc::TextStyle style;
+	style.height = 2.5f;
+	style.widthFactor = 0.8f;
+	style.oblique = 15;
+	style.rotation = 30;
+
+	Stage stage("layout");
+	uint64 points = 0;
+	for(uint32 a = 0; a < runs; a++)
+	{
+		uint64 count = allocations;
+		Clock::time_point start = Clock::now();
+		for(uint32 b = 0; b < kStrings; b++)
+		{
+			layout.layout(text.data() + b * kLength, kLength, style, outline);
+			points += outline.size();
+		}
+		stage.seconds.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+		stage.allocations += allocations - count;
+	}
+
+	std::vector<double> sorted = stage.seconds;
+	std::sort(sorted.begin(), sorted.end());
+	double median = std::max(percentile(sorted, 0.5), 1e-9);
+
+	std::cout << std::left << std::setw(12) << stage.name << std::right << std::fixed
+	          << std::setprecision(0) << std::setw(10) << kStrings / median << " strings/s"
+	          << std::setw(12) << kStrings * kLength / median << " glyphs/s"
+	          << std::setw(12) << points / runs / median << " points/s"
+	          << std::setw(12) << stage.allocations / runs << " allocs/run" << std::endl;
+}
+
+/*!
+ \brief Looks up random shapes in the compiled SHX file and prints the lookups per second. Each run
+ loads the file again, so that the time includes building the index.
+ */
+static void runLookup(const shpc::Compiler &compiler, uint32 runs, uint32 seed)
+{
+	const uint32 kLookups = 1000000;
+
+	const shpc::ShapeTable &shapes = compiler.shapes();
+	std::vector<uint16> numbers(kLookups);
+	uint32 random = seed;
+	for(size_t a = 0; a < numbers.size(); a++)
+	{
+		random = random * 1103515245 + 12345;
+		numbers[a] = shapes.number((random >> 8) % shapes.size());
+	}
+
+	const std::vector<uint8> &shx = compiler.image().data();
+	shpc::ShxFont font;
+
+	Stage stage("shx lookup");
+	uint64 bytes = 0;
+	for(uint32 a = 0; a < runs; a++)
+	{
+		uint64 count = allocations;
+		Clock::time_point start = Clock::now();
+		font.load(shx.data(), shx.size());
+		for(uint32 b = 0; b < kLookups; b++)bytes += font.shape(font.find(numbers[b])).defBytes;
+		stage.seconds.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+		stage.allocations += allocations - count;
+	}
+
+	std::vector<double> sorted = stage.seconds;
+	std::sort(sorted.begin(), sorted.end());
+	double median = std::max(percentile(sorted, 0.5), 1e-9);
+
+	std::cout << std::left << std::setw(12) << stage.name << std::right << std::fixed
+	          << std::setprecision(0) << std::setw(10) << kLookups / median << " lookups/s"
+	          << std::setw(12) << bytes / runs << " bytes"
+	          << std::setw(12) << stage.allocations / runs << " allocs/run" << std::endl;
+}
+
+/*!
+ \brief Decompiles the compiled SHX file and prints the throughput. Then the SHP text is compiled
+ again, which must give the same bytes.
+ */
+static void runDecompile(const shpc::Compiler &compiler, uint32 runs, shpc::ThreadPool &pool)
+{
+	const std::vector<uint8> &shx = compiler.image().data();
+	shpc::ShxDecompiler decompiler;
+	decompiler.setThreadPool(&pool);
+
+	Stage stage("decompile");
+	for(uint32 a = 0; a < runs; a++)
+	{
+		uint64 count = allocations;
+		Clock::time_point start = Clock::now();
+		decompiler.load(shx.data(), shx.size());
+		decompiler.decompile();
+		stage.seconds.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+		stage.allocations += allocations - count;
+	}
+	print(stage, shx.size(), compiler.shapes().size());
+
+	const std::string &shp = decompiler.text();
+	shpc::Compiler recompiler;
+	if(!recompiler.compile((const uint8*)shp.data(), shp.size()))
+	{
+		std::cout << "round trip  FAILED: " << recompiler.diagnostics().back().message << std::endl;
+		failures++;
+		return;
+	}
+
+	const std::vector<uint8> &result = recompiler.image().data();
+	size_t position = 0;
+	while(position < shx.size() && position < result.size() && shx[position] == result[position])
+		position++;
+
+	if(position == shx.size() && position == result.size())
+		std::cout << "round trip  identical" << std::endl;
+	else
+	{
+		std::cout << "round trip  FAILED: different at byte " << position << std::endl;
+		failures++;
+	}
+}
+
+/*!
+ \brief Compiles the font with the options and compares the bounding box and the advance of each
+ shape with the plainly compiled font. Shape 0 is not drawn and the subshapes, which are added by
+ the deduplication, only exist in the compiled font with options.
+ */
+static void runVariant(const shpc::Compiler &plain, const std::string &shp, const char* title,
+                       bool optimize, bool deduplicate, bool flatten)
+{
+	shpc::Compiler compiler;
+	compiler.setOptimize(optimize);
+	compiler.setDeduplicate(deduplicate);
+	compiler.setFlatten(flatten);
+	std::cout << std::left << std::setw(12) << title << std::right;
+	if(!compiler.compile((const uint8*)shp.data(), shp.size()))
+	{
+		std::cout << "FAILED: " << compiler.diagnostics().back().message << std::endl;
+		failures++;
+		return;
+	}
+
+	const shpc::ShapeTable &oldShapes = plain.shapes();
+	const shpc::ShapeTable &newShapes = compiler.shapes();
+	shpc::Interpreter oldInterpreter(oldShapes, shpc::wideSubshapes(plain.format()));
+	shpc::Interpreter newInterpreter(newShapes, shpc::wideSubshapes(compiler.format()));
+	shpc::Outline oldOutline;
+	shpc::Outline newOutline;
+
+	// The index of each shape number in the compiled font with options.
+	std::vector<uint32> index(65536, newShapes.size());
+	for(uint32 b = 0; b < newShapes.size(); b++)index[newShapes.number(b)] = b;
+
+	for(uint32 a = 0; a < oldShapes.size(); a++)
+	{
+		uint16 number = oldShapes.number(a);
+		uint32 b = index[number];
+		if(b == newShapes.size())
+		{
+			std::cout << "FAILED: shape " << number << " is missing" << std::endl;
+			failures++;
+			return;
+		}
+		if(number == 0)continue;
+
+		try
+		{
+			oldInterpreter.run(a, oldOutline);
+			newInterpreter.run(b, newOutline);
+		}
+		catch(jm::Exception &e)
+		{
+			std::cout << "FAILED: shape " << number << ": " << e.errorMessage() << std::endl;
+			failures++;
+			return;
+		}
+
+		if(oldOutline.minimum().x != newOutline.minimum().x
+		   || oldOutline.minimum().y != newOutline.minimum().y
+		   || oldOutline.maximum().x != newOutline.maximum().x
+		   || oldOutline.maximum().y != newOutline.maximum().y
+		   || oldOutline.advance().x != newOutline.advance().x
+		   || oldOutline.advance().y != newOutline.advance().y)
+		{
+			std::cout << "FAILED: geometry of shape " << number << " differs" << std::endl;
+			failures++;
+			return;
+		}
+	}
+	std::cout << "geometry identical, " << compiler.image().data().size() << " bytes" << std::endl;
+}
+
+/*!
+ \brief Measures all stages for one font.
+ */
+static void bench(shpc::FontType type, const char* title, uint32 glyphs, uint32 runs, uint32 seed,
+                  shpc::ThreadPool &pool)
+{
+	std::string shp = shpc::FontGenerator(type, glyphs, seed).generate();
+	const uint8* data = (const uint8*)shp.data();
+
+	std::cout << std::endl << title << ": " << glyphs << " glyphs, " << shp.size() << " bytes"
+	          << std::endl;
+	std::cout << std::left << std::setw(12) << "stage" << std::right << std::setw(10) << "MB/s"
+	          << std::setw(12) << "glyphs/s" << std::setw(10) << "p50 ms" << std::setw(10)
+	          << "p90 ms" << std::setw(10) << "p99 ms" << std::setw(12) << "allocs/run"
+	          << std::endl;
+
+	Stage reader("reader");
+	Stage lexer("lexer");
+	Stage tokenize("tokenize");
+	Stage check("check");
+	Stage write("write");
+	Stage compile("compile");
+	Stage parallel("compile -j");
+
+	// The compiler objects are reused like in a server.
+	shpc::Compiler serial;
+	shpc::Compiler threaded;
+	threaded.setThreadPool(&pool);
+
+	volatile uint32 sink = 0;
+	for(uint32 a = 0; a < runs; a++)
+	{
+		uint64 count = allocations;
+		Clock::time_point start = Clock::now();
+		sink = sink + runReader(shp);
+		reader.seconds.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+		reader.allocations += allocations - count;
+
+		count = allocations;
+		start = Clock::now();
+		sink = sink + runLexer(shp);
+		lexer.seconds.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+		lexer.allocations += allocations - count;
+
+		count = allocations;
+		start = Clock::now();
+		if(!serial.compile(data, shp.size()))
+		{
+			std::cout << "Compilation failed: " << serial.diagnostics().back().message << std::endl;
+			return;
+		}
+		compile.seconds.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+		compile.allocations += allocations - count;
+
+		tokenize.seconds.push_back(serial.times().tokenize);
+		check.seconds.push_back(serial.times().check);
+		write.seconds.push_back(serial.times().write);
+
+		count = allocations;
+		start = Clock::now();
+		threaded.compile(data, shp.size());
+		parallel.seconds.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+		parallel.allocations += allocations - count;
+	}
+
+	// The compiler phases are part of the compile run, their allocations are not separated.
+	print(reader, shp.size(), glyphs);
+	print(lexer, shp.size(), glyphs);
+	print(tokenize, shp.size(), glyphs);
+	print(check, shp.size(), glyphs);
+	print(write, shp.size(), glyphs);
+	print(compile, shp.size(), glyphs);
+	print(parallel, shp.size(), glyphs);
+
+	runLayout(serial, runs, seed);
+	runLookup(serial, runs, seed);
+	runDecompile(serial, runs, pool);
+
+	runVariant(serial, shp, "-O", true, false, false);
+	runVariant(serial, shp, "--dedup", false, true, false);
+	runVariant(serial, shp, "--flatten", false, false, true);
+	runVariant(serial, shp, "-O --dedup", true, true, false);
+}
+
+/*!
+ \brief Main method of the benchmark.
+ */
+int main(int argc, const char* argv[])
+{
+	jm::System::init(jm::kEmptyString);
+
+	uint32 glyphs = 20000;
+	uint32 runs = 20;
+	uint32 seed = 1;
+	uint32 threads = 0;
+	jm::String fontname;
+
+	for(int a = 1; a < argc; a++)
+	{
+		jm::String cmd = argv[a];
+		if(a == argc - 1)
+		{
+			std::cout << "usage: shpc-bench [-n glyphs] [-r runs] [-s seed] [-j threads] [-w file.shp]"
+			          << std::endl;
+			jm::System::quit();
+			return 1;
+		}
+
+		if(cmd.equals("-w"))
+		{
+			fontname = argv[++a];
+			continue;
+		}
+
+		uint32 value = (uint32)jm::String(argv[++a]).toInt();
+		if(cmd.equals("-n"))glyphs = std::min(std::max(value, (uint32)1), (uint32)65535);
+		else if(cmd.equals("-r"))runs = std::max(value, (uint32)1);
+		else if(cmd.equals("-s"))seed = value;
+		else if(cmd.equals("-j"))threads = value;
+	}
+
+	shpc::ThreadPool pool(threads);
+	std::cout << "shpc benchmark, " << runs << " runs, " << pool.size() << " threads" << std::endl;
+
+	bench(shpc::FontType::kShapes10, "Shapes 1.0", glyphs, runs, seed, pool);
+	bench(shpc::FontType::kShapes11, "Shapes 1.1", std::min(glyphs, (uint32)65534), runs, seed, pool);
+	bench(shpc::FontType::kUnifont, "Unifont", std::min(glyphs, (uint32)65534), runs, seed, pool);
+	bench(shpc::FontType::kBigfont, "Bigfont", std::min(glyphs, (uint32)32895), runs, seed, pool);
+
+	// The Unifont is saved for further checks, e.g. of the header, which shpc emits.
+	if(fontname.size() > 0)
+	{
+		std::string shp = shpc::FontGenerator(shpc::FontType::kUnifont,
+		                                      std::min(glyphs, (uint32)65534),
+		                                      seed).generate();
+		try
+		{
+			shpc::saveAtomic(fontname, (const uint8*)shp.data(), shp.size());
+		}
+		catch(jm::Exception &e)
+		{
+			std::cout << "Saving failed: " << e.errorMessage() << std::endl;
+			failures++;
+		}
+	}
+
+	jm::System::quit();
+	return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,307 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        FontGenerator.cpp
+// Application: Shape File Compiler
+// Purpose:     Synthetic SHP files for benchmarks
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "FontGenerator.h"
+
+using namespace shpc;
+
+FontGenerator::FontGenerator(FontType type, uint32 glyphs, uint32 seed): mRandom(seed)
+{
+	mType = type;
+
+	// The header of Unicode and 1.1 fonts is shape 0 and counts as well.
+	mGlyphs = std::min(glyphs, type == FontType::kShapes10 ? (uint32)65535 : (uint32)65534);
+
+	// The lead bytes 0x80 to 0xFF leave 127 single byte and 32768 double byte characters.
+	if(type == FontType::kBigfont)mGlyphs = std::min(mGlyphs, (uint32)32895);
+}
+
+int32 FontGenerator::random(int32 min, int32 max)
+{
+	return std::uniform_int_distribution<int32>(min, max)(mRandom);
+}
+
+/*!
+ \brief Writes a spec byte in decimal or hexadecimal notation. Hexadecimal numbers start with 0 and
+ a minus sign sets the highest bit.
+ */
+std::string FontGenerator::number(int32 value)
+{
+	std::ostringstream str;
+	if(value >= 0 && random(0, 2) == 0)str << "0" << std::uppercase << std::hex << value;
+	else str << value;
+	return str.str();
+}
+
+/*!
+ \brief Returns a displacement, which is never 0, so that it does not end a list of 9 or 13.
+ */
+std::string FontGenerator::coordinate()
+{
+	int32 value = random(1, 127);
+	if(random(0, 1) == 0)value = -value;
+	return number(value);
+}
+
+/*!
+ \brief Adds a vector byte: length in the high nibble (1-15), direction in the low nibble.
+ */
+void FontGenerator::vector(std::vector<std::string> &tokens)
+{
+	tokens.push_back(number((random(1, 15) << 4) | random(0, 15)));
+}
+
+/*!
+ \brief Adds one command with its parameters.
+ */
+void FontGenerator::command(std::vector<std::string> &tokens, int32 &stack)
+{
+	int32 code = random(0, 20);
+	switch(code)
+	{
+		case 1:
+		case 2:
+			tokens.push_back(number(code));
+			break;
+
+		case 3:
+		case 4:
+			tokens.push_back(number(code));
+			tokens.push_back(number(random(1, 127)));
+			break;
+
+		case 5:
+			if(stack >= 4)break;
+			tokens.push_back("5");
+			stack++;
+			break;
+
+		case 6:
+			if(stack <= 0)break;
+			tokens.push_back("6");
+			stack--;
+			break;
+
+		case 7:
+		{
+			// Normal fonts can only refer to the shapes 1 to 255, which are the first numbers.
+			bool wide = mType == FontType::kUnifont || mType == FontType::kBigfont;
+			size_t count = mNumbers.size();
+			if(!wide)
+				count = std::upper_bound(mNumbers.begin(), mNumbers.end(), 255) - mNumbers.begin();
+			if(count == 0)break;
+
+			uint16 ref = mNumbers[random(0, (int32)count - 1)];
+			tokens.push_back("7");
+			if(wide)
+			{
+				// Two bytes, either as two tokens or as one long hexadecimal token.
+				std::ostringstream str;
+				if(random(0, 1) == 0)str << "0" << std::uppercase << std::hex << (ref >> 8) << ",0"
+					                     << (ref & 0xFF);
+				else str << "0" << std::uppercase << std::hex << std::setfill('0') << std::setw(4)
+					         << ref;
+				tokens.push_back(str.str());
+			}
+			else tokens.push_back(number(ref));
+			break;
+		}
+
+		case 8:
+			tokens.push_back("8");
+			tokens.push_back("(" + coordinate());
+			tokens.push_back(coordinate() + ")");
+			break;
+
+		case 9:
+		case 13:
+		{
+			tokens.push_back(number(code));
+			int32 count = random(1, 8);
+			for(int32 a = 0; a < count; a++)
+			{
+				tokens.push_back("(" + coordinate());
+				if(code == 9)tokens.push_back(coordinate() + ")");
+				else
+				{
+					tokens.push_back(coordinate());
+					tokens.push_back(number(random(-127, 127)) + ")");
+				}
+			}
+			tokens.push_back("(0");
+			tokens.push_back("0)");
+			break;
+		}
+
+		case 10:
+			tokens.push_back("10");
+			tokens.push_back("(" + number(random(1, 255)));
+			tokens.push_back((random(0, 1) ? "-0" : "0") + std::to_string(random(0, 7))
+			                 + std::to_string(random(0, 7)) + ")");
+			break;
+
+		case 11:
+			tokens.push_back("11");
+			tokens.push_back("(" + number(random(0, 255)));
+			tokens.push_back(number(random(0, 255)));
+			tokens.push_back(number(random(0, 3)));
+			tokens.push_back(number(random(1, 255)));
+			tokens.push_back((random(0, 1) ? "-0" : "0") + std::to_string(random(0, 7))
+			                 + std::to_string(random(0, 7)) + ")");
+			break;
+
+		case 12:
+			tokens.push_back("12");
+			tokens.push_back("(" + coordinate());
+			tokens.push_back(coordinate());
+			tokens.push_back(number(random(-127, 127)) + ")");
+			break;
+
+		case 14:
+			tokens.push_back("14");
+			if(random(0, 1) == 0)vector(tokens);
+			else
+			{
+				tokens.push_back("8");
+				tokens.push_back("(" + coordinate());
+				tokens.push_back(coordinate() + ")");
+			}
+			break;
+
+		default:
+			vector(tokens);
+			break;
+	}
+}
+
+/*!
+ \brief Writes the header line and the spec byte lines of one shape.
+ */
+void FontGenerator::shape(std::string &out, uint16 shapeNumber)
+{
+	std::vector<std::string> tokens;
+	int32 stack = 0;
+	int32 count = random(3, 24);
+	for(int32 a = 0; a < count; a++)command(tokens, stack);
+	while(stack-- > 0)tokens.push_back("6");
+	tokens.push_back("0");
+
+	// Tokens with more than 4 characters are two bytes.
+	uint32 bytes = 0;
+	for(size_t a = 0; a < tokens.size(); a++)
+	{
+		std::string token = tokens[a];
+		token.erase(std::remove(token.begin(), token.end(), '('), token.end());
+		token.erase(std::remove(token.begin(), token.end(), ')'), token.end());
+		if(token.find(',') != std::string::npos)bytes += 2;
+		else bytes += token.size() > 4 ? 2 : 1;
+	}
+
+	std::ostringstream header;
+	if((mType == FontType::kUnifont || mType == FontType::kBigfont) && random(0, 1) == 0)
+		header << "*0" << std::uppercase << std::hex << shapeNumber;
+	else header << "*" << shapeNumber;
+	header << std::dec << "," << bytes << ",";
+	if(mType == FontType::kUnifont)header << "uni" << std::hex << std::setfill('0') << std::setw(4)
+		                                     << shapeNumber;
+	else if(mType == FontType::kBigfont)header << "BIG" << shapeNumber;
+	else header << "SHP" << shapeNumber;
+	if(random(0, 4) == 0)header << ";generated";
+
+	out.append(header.str());
+	out.append("\n");
+
+	// Lines of different length, some with comment.
+	size_t a = 0;
+	while(a < tokens.size())
+	{
+		size_t length = random(1, 16);
+		std::string line;
+		for(size_t b = 0; b < length && a < tokens.size(); b++, a++)
+		{
+			if(b > 0)line.append(random(0, 3) == 0 ? ", " : ",");
+			line.append(tokens[a]);
+		}
+		if(a < tokens.size())line.append(",");
+		if(random(0, 9) == 0)line.append(" ;comment");
+		out.append(line);
+		out.append("\n");
+	}
+
+	mNumbers.push_back(shapeNumber);
+}
+
+std::string FontGenerator::generate()
+{
+	std::string out;
+	out.reserve(mGlyphs * 200);
+	mNumbers.clear();
+
+	// The header of the font.
+	switch(mType)
+	{
+		case FontType::kUnifont:
+			out.append("*UNIFONT,6,Synthetic Unifont\n21,7,2,1,1,0\n");
+			break;
+
+		case FontType::kShapes11:
+			out.append("*0,4,Synthetic Font\n21,7,2,0\n");
+			break;
+
+		case FontType::kBigfont:
+			out.append("*BIGFONT " + std::to_string(mGlyphs + 1) + ",1,080,0FF\n");
+			out.append("*0,5,Synthetic Bigfont\n21,0,2,21,0\n");
+			break;
+
+		case FontType::kShapes10:
+			break;
+	}
+
+	// Ascending shape numbers, spread over the whole range. Bigfonts have single byte characters
+	// below the escape range and double byte characters with a lead byte in it.
+	std::vector<uint16> numbers;
+	for(uint32 a = 1; a <= 65535; a++)
+	{
+		if(mType == FontType::kBigfont && a >= 0x80 && a < 0x8000)continue;
+		numbers.push_back((uint16)a);
+	}
+	std::shuffle(numbers.begin(), numbers.end(), mRandom);
+	numbers.resize(mGlyphs);
+	std::sort(numbers.begin(), numbers.end());
+
+	for(size_t a = 0; a < numbers.size(); a++)shape(out, numbers[a]);
+
+	return out;
+}
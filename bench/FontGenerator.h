@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        FontGenerator.h
+// Application: Shape File Compiler
+// Purpose:     Synthetic SHP files for benchmarks
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_FontGenerator_h
+#define shpc_FontGenerator_h
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/Core.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The formats of SHP files.
+	 */
+	enum class FontType
+	{
+		kShapes10,
+		kShapes11,
+		kUnifont,
+		kBigfont
+	};
+
+	/*!
+	 \brief The generator creates synthetic SHP files, which are valid and similar to real fonts.
+	 The shapes use all commands 0 to 14, including multi-line 9 and 13 and fractional arcs 11, and
+	 the spec bytes are written in decimal and hexadecimal notation on lines of varying length. The
+	 same seed creates the same file.
+	 */
+	class FontGenerator
+	{
+		public:
+
+			/*!
+			 \brief Constructor
+			 \param type The format of the file.
+			 \param glyphs The number of shapes, at most 65535 including the font header. Bigfonts
+			 have at most 32895 shapes: 127 single byte and 32768 double byte characters.
+			 \param seed The start value of the random numbers.
+			 */
+			FontGenerator(FontType type, uint32 glyphs, uint32 seed);
+
+			/*!
+			 \brief Creates the content of the SHP file.
+			 */
+			std::string generate();
+
+		private:
+
+			// The format of the file.
+			FontType mType;
+
+			// The number of shapes.
+			uint32 mGlyphs;
+
+			// The random numbers.
+			std::mt19937 mRandom;
+
+			// The numbers of the shapes already written, e.g. for subshapes.
+			std::vector<uint16> mNumbers;
+
+			int32 random(int32 min, int32 max);
+
+			std::string number(int32 value);
+
+			std::string coordinate();
+
+			void vector(std::vector<std::string> &tokens);
+
+			void command(std::vector<std::string> &tokens, int32 &stack);
+
+			void shape(std::string &out, uint16 number);
+	};
+
+}
+
+#endif
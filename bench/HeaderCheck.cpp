@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        HeaderCheck.cpp
+// Application: Shape File Compiler
+// Purpose:     Check of the header, which shpc emits with --header
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The header is included twice, so that its include guard is checked as well. "make check"
+// emits it into bin/check.h.
+#include "check.h"
+#include "check.h"
+
+// The lookup must be possible at compile time.
+static_assert(check::find(check::kGlyphs[0].number) == 0, "First shape not found.");
+static_assert(check::find(check::kGlyphs[check::kGlyphCount - 1].number) == check::kGlyphCount - 1,
+              "Last shape not found.");
+
+/*!
+ \brief Finds each shape of the header and checks, that its record lies within kShx.
+ \return 0, if all shapes are found, 1 otherwise.
+ */
+int main()
+{
+	for(std::size_t a = 0; a < check::kGlyphCount; a++)
+	{
+		const check::Glyph &glyph = check::kGlyphs[a];
+		if(check::find(glyph.number) != a)return 1;
+		if(glyph.offset + glyph.nameLength + 1 + glyph.defBytes > sizeof(check::kShx))return 1;
+	}
+	return 0;
+}
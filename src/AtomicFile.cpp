@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        AtomicFile.cpp
+// Application: Shape File Compiler
+// Purpose:     Atomic saving of files
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include <atomic>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <process.h>
+#endif
+
+#include "AtomicFile.h"
+
+using namespace shpc;
+
+/*!
+ \brief Returns a name for the temporary file of the target, which is unique for this process and
+ call.
+ */
+static jm::String tempName(const jm::String &filename)
+{
+	static std::atomic<uint32> counter(0);
+
+#ifndef _WIN32
+	int64 process = (int64)getpid();
+#else
+	int64 process = (int64)_getpid();
+#endif
+
+	return filename + "."
+	       + jm::String::valueOf(process) + "."
+	       + jm::String::valueOf((int64)counter++) + ".tmp";
+}
+
+/*!
+ \brief Removes the temporary file after an error.
+ */
+static void removeTemp(const jm::String &tempname)
+{
+	jm::ByteArray path = tempname.toCString();
+	std::remove(path.constData());
+}
+
+void shpc::saveAtomic(const jm::String &filename, const uint8* data, size_t length)
+{
+	jm::String tempname = tempName(filename);
+
+	jm::File file(tempname);
+	int64 written;
+	try
+	{
+		file.open(jm::FileMode::kWrite);
+		written = length > 0 ? file.write(data, length) : 0;
+		file.close();
+	}
+	catch(jm::Exception &)
+	{
+		file.close();
+		removeTemp(tempname);
+		throw jm::Exception("Cannot write file: " + filename);
+	}
+
+	if(written != (int64)length)
+	{
+		removeTemp(tempname);
+		throw jm::Exception("Cannot write file: " + filename);
+	}
+
+	if(!file.renameTo(filename))
+	{
+		removeTemp(tempname);
+		throw jm::Exception("Cannot rename \"" + tempname + "\" to \"" + filename + "\".");
+	}
+}
@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        AtomicFile.h
+// Application: Shape File Compiler
+// Purpose:     Atomic saving of files
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef shpc_AtomicFile_h
+#define shpc_AtomicFile_h
+
+#include "core/Core.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief Saves the data into the file. The data is written into a temporary file next to the
+	 target, which then replaces the target, so readers never see a partially written file. The
+	 name of the temporary file is unique for each call, so several threads and processes can save
+	 the same target at once. On errors the temporary file is removed and the target is unchanged.
+	 \throws jm::Exception, if the file cannot be written.
+	 */
+	void saveAtomic(const jm::String &filename, const uint8* data, size_t length);
+
+}
+
+#endif
@@ -0,0 +1,279 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Batch.cpp
+// Application: Shape File Compiler
+// Purpose:     Parallel compilation of many SHP files
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+#include "Batch.h"
+
+using namespace shpc;
+
+typedef std::chrono::steady_clock Clock;
+
+jm::String shpc::shxName(const jm::String &input, const jm::String &directory)
+{
+	jm::String output = input;
+	if(directory.size() > 0)output = directory + "/" + jm::File(input).name();
+
+	if(output.toLowerCase().endsWith(".shp"))
+		output = output.substring(0, output.size() - 4);
+
+	output.append(".shx");
+	return output;
+}
+
+Batch::Batch()
+{
+	mVerbose = false;
+	mIncremental = false;
+	mFlatten = false;
+	mOptimize = false;
+	mDeduplicate = false;
+	mTrace = nullptr;
+	mPool = nullptr;
+}
+
+void Batch::setVerbose(bool verbose)
+{
+	mVerbose = verbose;
+}
+
+void Batch::setOutputDirectory(const jm::String &directory)
+{
+	mOutputDirectory = directory;
+}
+
+void Batch::setIncremental(bool incremental)
+{
+	mIncremental = incremental;
+}
+
+void Batch::setFlatten(bool flatten)
+{
+	mFlatten = flatten;
+}
+
+void Batch::setOptimize(bool optimize)
+{
+	mOptimize = optimize;
+}
+
+void Batch::setDeduplicate(bool deduplicate)
+{
+	mDeduplicate = deduplicate;
+}
+
+void Batch::setTrace(Trace* trace)
+{
+	mTrace = trace;
+}
+
+void Batch::add(const jm::String &input)
+{
+	if(input.startsWith("@"))
+	{
+		addResponseFile(input.substring(1));
+		return;
+	}
+
+	jm::File file(input);
+	if(file.isDirectory())
+	{
+		addDirectory(file);
+		return;
+	}
+
+	BatchResult result;
+	result.input = input;
+	result.output = shxName(input, mOutputDirectory);
+	mResults.push_back(result);
+}
+
+/*!
+ \brief Adds all SHP files of the directory and its subdirectories.
+ */
+void Batch::addDirectory(jm::File &directory)
+{
+	std::vector<jm::File*> files = directory.listFiles();
+	for(size_t a = 0; a < files.size(); a++)
+	{
+		jm::File* file = files[a];
+		if(file->isDirectory())addDirectory(*file);
+		else if(file->name().toLowerCase().endsWith(".shp"))add(file->absolutePath());
+		delete file;
+	}
+}
+
+/*!
+ \brief Adds the inputs listed in the response file. Each line contains one input. Everything after
+ a semicolon is comment.
+ */
+void Batch::addResponseFile(const jm::String &filename)
+{
+	jm::File file(filename);
+	if(!file.exists())throw jm::Exception("Response file \"" + filename + "\" does not exist.");
+
+	file.open(jm::FileMode::kRead);
+	ShpReader reader;
+	reader.load(&file);
+	file.close();
+
+	ShpLine line;
+	while(reader.nextLine(line))
+	{
+		Token token;
+		token.data = line.data;
+		token.length = line.codeLength;
+		token = trim(token);
+		if(token.length == 0)continue;
+
+		// File names are UTF-8 encoded
+		std::string name((const char*)token.data, token.length);
+		add(jm::String(name.c_str()));
+	}
+}
+
+uint32 Batch::size() const
+{
+	return (uint32)mResults.size();
+}
+
+/*!
+ \brief Compiles one file and saves the SHX file. All errors are reported in the result.
+ */
+void Batch::compile(BatchResult &result)
+{
+	TraceSpan span(mTrace, "compile", "file", result.input);
+
+	Compiler compiler;
+	compiler.setVerbose(mVerbose);
+	compiler.setThreadPool(mPool);
+	compiler.setTrace(mTrace);
+	compiler.setFlatten(mFlatten);
+	compiler.setOptimize(mOptimize);
+	compiler.setDeduplicate(mDeduplicate);
+
+	ShapeCache cache;
+	if(mIncremental)compiler.setCache(&cache);
+
+	try
+	{
+		if(mIncremental)cache.load(ShapeCache::filename(result.output));
+
+		jm::File file(result.input);
+		if(!file.exists())throw jm::Exception("Input file \"" + result.input + "\" does not exist");
+
+		file.open(jm::FileMode::kRead);
+		result.success = compiler.compile(&file);
+		file.close();
+		result.diagnostics = compiler.diagnostics();
+		result.times = compiler.times();
+		result.bytesIn = compiler.inputSize();
+
+		if(result.success)
+		{
+			result.bytesOut = compiler.image().data().size();
+			result.glyphs = compiler.shapes().size();
+
+			Clock::time_point start = Clock::now();
+			{
+				TraceSpan save(mTrace, "save", "phase");
+				compiler.image().save(result.output);
+				if(mIncremental)cache.save(ShapeCache::filename(result.output));
+			}
+			result.save = std::chrono::duration<double>(Clock::now() - start).count();
+		}
+	}
+	catch(jm::Exception &e)
+	{
+		result.diagnostics.push_back(Diagnostic(Severity::kError, 0, e.errorMessage()));
+		result.success = false;
+	}
+}
+
+void Batch::run(ThreadPool &pool)
+{
+	// Large files are also compiled in parallel on the same pool.
+	mPool = &pool;
+
+	// Files with the same output, e.g. from different directories or listed twice, would
+	// overwrite each other in parallel. Only the first of them is compiled.
+	std::unordered_map<std::string, size_t> outputs;
+	std::vector<bool> duplicate(mResults.size(), false);
+	for(size_t a = 0; a < mResults.size(); a++)
+	{
+		BatchResult &result = mResults[a];
+		jm::ByteArray path = jm::File(result.output).absolutePath().toCString();
+		std::string key(path.constData(), (size_t)path.size());
+
+		auto first = outputs.find(key);
+		if(first == outputs.end())
+		{
+			outputs[key] = a;
+			continue;
+		}
+
+		duplicate[a] = true;
+		result.success = false;
+		result.diagnostics.push_back(Diagnostic(Severity::kError, 0, "Output file \""
+		                                        + result.output
+		                                        + "\" is also written for \""
+		                                        + mResults[first->second].input
+		                                        + "\"."));
+	}
+
+	TaskGroup group;
+	for(size_t a = 0; a < mResults.size(); a++)
+	{
+		if(duplicate[a])continue;
+		BatchResult* result = &mResults[a];
+		pool.submit([this, result] {compile(*result);}, &group);
+	}
+	pool.wait(group);
+
+	mPool = nullptr;
+}
+
+const std::vector<BatchResult>& Batch::results() const
+{
+	return mResults;
+}
+
+uint32 Batch::failures() const
+{
+	uint32 count = 0;
+	for(size_t a = 0; a < mResults.size(); a++)
+	{
+		if(!mResults[a].success)count++;
+	}
+	return count;
+}
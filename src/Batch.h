@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Batch.h
+// Application: Shape File Compiler
+// Purpose:     Parallel compilation of many SHP files
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_Batch_h
+#define shpc_Batch_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+#include "Compiler.h"
+#include "ThreadPool.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief Result of the compilation of one file in a batch.
+	 */
+	struct BatchResult
+	{
+		// Name of the SHP file.
+		jm::String input;
+
+		// Name of the SHX file.
+		jm::String output;
+
+		// Status whether the file was compiled and saved.
+		bool success;
+
+		// The messages of the compiler.
+		std::vector<Diagnostic> diagnostics;
+
+		// The duration of the phases of the compilation.
+		PhaseTimes times;
+
+		// The duration of saving the SHX file in seconds.
+		double save;
+
+		// The number of bytes of the SHP file.
+		uint64 bytesIn;
+
+		// The number of bytes of the SHX file.
+		uint64 bytesOut;
+
+		// The number of shapes.
+		uint32 glyphs;
+
+		BatchResult()
+		{
+			success = false;
+			save = 0;
+			bytesIn = 0;
+			bytesOut = 0;
+			glyphs = 0;
+		}
+	};
+
+	/*!
+	 \brief Returns the name of the SHX file for the given SHP file. The extension ".shp" is replaced
+	 by ".shx". If a directory is given, the SHX file is placed there.
+	 */
+	jm::String shxName(const jm::String &input, const jm::String &directory = jm::kEmptyString);
+
+	/*!
+	 \brief A batch compiles many SHP files in parallel. Each file is compiled by its own compiler
+	 object in a task of a thread pool.
+	 */
+	class Batch
+	{
+		public:
+
+			Batch();
+
+			/*!
+			 \brief Status whether detailed information is added to the diagnostics.
+			 */
+			void setVerbose(bool verbose);
+
+			/*!
+			 \brief Sets the directory for the SHX files. If empty, each SHX file is placed next to
+			 its SHP file.
+			 */
+			void setOutputDirectory(const jm::String &directory);
+
+			/*!
+			 \brief Status whether unchanged shapes are taken from the cache file next to each SHX
+			 file.
+			 */
+			void setIncremental(bool incremental);
+
+			/*!
+			 \brief Status whether the subshape references are replaced by the subshapes.
+			 */
+			void setFlatten(bool flatten);
+
+			/*!
+			 \brief Status whether the spec bytes are optimized.
+			 */
+			void setOptimize(bool optimize);
+
+			/*!
+			 \brief Status whether repeated runs of commands are moved into subshapes.
+			 */
+			void setDeduplicate(bool deduplicate);
+
+			/*!
+			 \brief Sets the trace, in which each file and the phases of its compilation are
+			 recorded.
+			 */
+			void setTrace(Trace* trace);
+
+			/*!
+			 \brief Adds an input. The input is either a SHP file, a directory, which is searched
+			 recursively for SHP files, or a response file prefixed with "@", which contains one
+			 input per line.
+			 */
+			void add(const jm::String &input);
+
+			/*!
+			 \brief Returns the number of files in the batch.
+			 */
+			uint32 size() const;
+
+			/*!
+			 \brief Compiles all files on the thread pool and waits for the end. If several files
+			 have the same SHX file, only the first one is compiled, the others fail.
+			 */
+			void run(ThreadPool &pool);
+
+			/*!
+			 \brief Returns the results in the order, in which the files were added.
+			 */
+			const std::vector<BatchResult>& results() const;
+
+			/*!
+			 \brief Returns the number of files, which could not be compiled.
+			 */
+			uint32 failures() const;
+
+		private:
+
+			// Status whether detailed information is reported.
+			bool mVerbose;
+
+			// Status whether the cache files are used.
+			bool mIncremental;
+
+			// Status whether the subshapes are flattened.
+			bool mFlatten;
+
+			// Status whether the spec bytes are optimized.
+			bool mOptimize;
+
+			// Status whether repeated runs are moved into subshapes.
+			bool mDeduplicate;
+
+			// The trace or nullptr.
+			Trace* mTrace;
+
+			// The pool during the run.
+			ThreadPool* mPool;
+
+			// The directory for the SHX files.
+			jm::String mOutputDirectory;
+
+			// The results, one per file.
+			std::vector<BatchResult> mResults;
+
+			void addDirectory(jm::File &directory);
+
+			void addResponseFile(const jm::String &filename);
+
+			void compile(BatchResult &result);
+	};
+
+}
+
+#endif
@@ -0,0 +1,1028 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Compiler.cpp
+// Application: Shape File Compiler
+// Purpose:     Reentrant compiler for SHP files
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+
+#include "Compiler.h"
+#include "Deduplicator.h"
+#include "Optimizer.h"
+#include "SpecValidator.h"
+
+using namespace shpc;
+
+jm::Charset* shpc::windowsCharset()
+{
+	// The initialization of local statics is thread safe.
+	static jm::Charset* cs = jm::Charset::forName("Windows-1252");
+	return cs;
+}
+
+/*!
+ \brief This method converts a token into a string. Each byte becomes one character.
+ */
+static jm::String toString(const Token &token)
+{
+	jm::String str;
+	for(uint32 a = 0; a < token.length; a++)
+	{
+		str.append(jm::Char(token.data[a]));
+	}
+	return str;
+}
+
+/*!
+ \brief Returns true, if the code part of the line starts with the given ASCII prefix.
+ */
+static bool startsWith(const ShpLine &line, const char* prefix)
+{
+	uint32 length = (uint32)std::strlen(prefix);
+	if(line.codeLength < length)return false;
+	return std::memcmp(line.data, prefix, length) == 0;
+}
+
+/*!
+ \brief Returns true, if the token equals the given ASCII string ignoring the case.
+ */
+static bool equalsIgnoreCase(const Token &token, const char* str)
+{
+	uint32 length = (uint32)std::strlen(str);
+	if(token.length != length)return false;
+	for(uint32 a = 0; a < length; a++)
+	{
+		if(std::toupper(token.data[a]) != std::toupper((uint8)str[a]))return false;
+	}
+	return true;
+}
+
+typedef std::chrono::steady_clock Clock;
+
+/*!
+ \brief Returns the seconds since the start.
+ */
+static double seconds(const Clock::time_point &start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/*!
+ \brief Files of at least this size are read in parallel, if a thread pool is set.
+ */
+static const size_t kParallelSize = 1024 * 1024;
+
+/*!
+ \brief The minimum number of bytes of a chunk, which is read by one task.
+ */
+static const size_t kChunkSize = 256 * 1024;
+
+/*!
+ \brief The minimum number of shapes, which are checked by one task.
+ */
+static const uint32 kSectionShapes = 2048;
+
+/*!
+ \brief The number of tasks per thread. More tasks than threads balance chunks with different
+ costs.
+ */
+static const uint32 kTasksPerThread = 4;
+
+/*!
+ \brief The start value of the hashes of shapes in Unicode fonts. Spec bytes are checked differently
+ in Unicode fonts, so the same source text must not match a shape of a normal font.
+ */
+static const uint64 kUnicodeSeed = 0x9E3779B97F4A7C15ULL;
+
+Compiler::Compiler()
+{
+	mVerbose = false;
+	mPool = nullptr;
+	mCache = nullptr;
+	mTrace = nullptr;
+	mFlatten = false;
+	mOptimize = false;
+	mDeduplicate = false;
+	mResolveReferences = true;
+	reset();
+}
+
+void Compiler::setVerbose(bool verbose)
+{
+	mVerbose = verbose;
+}
+
+void Compiler::setThreadPool(ThreadPool* pool)
+{
+	mPool = pool;
+}
+
+void Compiler::setTrace(Trace* trace)
+{
+	mTrace = trace;
+}
+
+void Compiler::setCache(ShapeCache* cache)
+{
+	mCache = cache;
+}
+
+void Compiler::setFlatten(bool flatten)
+{
+	mFlatten = flatten;
+}
+
+void Compiler::setOptimize(bool optimize)
+{
+	mOptimize = optimize;
+}
+
+void Compiler::setDeduplicate(bool deduplicate)
+{
+	mDeduplicate = deduplicate;
+}
+
+void Compiler::setResolveReferences(bool resolve)
+{
+	mResolveReferences = resolve;
+}
+
+uint32 Compiler::savedBytes() const
+{
+	return mSavedBytes;
+}
+
+uint32 Compiler::cachedShapes() const
+{
+	uint32 count = 0;
+	for(size_t a = 0; a < mCached.size(); a++)count += mCached[a];
+	return count;
+}
+
+/*!
+ \brief Resets the state of a previous compilation.
+ */
+void Compiler::reset()
+{
+	mLine = 0;
+	mFiletype = jm::kEmptyString;
+	mFormat = ShxFormat::kShapes10;
+	mIsUnicode = false;
+	mWide = false;
+	mEscapes.clear();
+	mBigfontCount = 0;
+	mBigfontHeader = false;
+	mShapeCount = 0;
+	mShapes.clear();
+	mHashes.clear();
+	mCached.clear();
+	mSavedBytes = 0;
+	mTimes = PhaseTimes();
+	mImage.allocate(0);
+	mDiagnostics.clear();
+}
+
+/*!
+ \brief Adds a message for the current line.
+ */
+void Compiler::report(Severity severity, const jm::String &message)
+{
+	mDiagnostics.push_back(Diagnostic(severity, mLine, message));
+}
+
+bool Compiler::compile(const uint8* data, size_t length)
+{
+	reset();
+	mReader.load(data, length);
+	return run();
+}
+
+bool Compiler::compile(jm::File* file)
+{
+	reset();
+
+	Clock::time_point start = Clock::now();
+	{
+		TraceSpan span(mTrace, "read", "phase");
+		mReader.load(file);
+	}
+	mTimes.read = seconds(start);
+
+	return run();
+}
+
+const ShxImage& Compiler::image() const
+{
+	return mImage;
+}
+
+const std::vector<Diagnostic>& Compiler::diagnostics() const
+{
+	return mDiagnostics;
+}
+
+bool Compiler::hasErrors() const
+{
+	for(size_t a = 0; a < mDiagnostics.size(); a++)
+	{
+		if(mDiagnostics[a].severity == Severity::kError)return true;
+	}
+	return false;
+}
+
+const PhaseTimes& Compiler::times() const
+{
+	return mTimes;
+}
+
+size_t Compiler::inputSize() const
+{
+	return mReader.size();
+}
+
+const ShapeTable& Compiler::shapes() const
+{
+	return mShapes;
+}
+
+const ShapeGraph& Compiler::graph() const
+{
+	return mGraph;
+}
+
+bool Compiler::isUnicode() const
+{
+	return mIsUnicode;
+}
+
+ShxFormat Compiler::format() const
+{
+	return mFormat;
+}
+
+const std::vector<EscapeRange>& Compiler::escapeRanges() const
+{
+	return mEscapes;
+}
+
+const jm::String& Compiler::filetype() const
+{
+	return mFiletype;
+}
+
+/*!
+ \brief This method evaluates the header of a bigfont: "*BIGFONT count,ranges,first,last,...". It
+ gives the number of shapes and the ranges of the lead bytes of double byte characters.
+ */
+void Compiler::handleBigfontLine(const ShpLine &line)
+{
+	if(mFormat != ShxFormat::kBigfont || mBigfontHeader || mShapeCount > 0)
+		throw jm::Exception("BIGFONT header must be the first line.");
+	mBigfontHeader = true;
+
+	// The keyword is followed by a space or a comma.
+	uint32 start = 8;
+	if(start < line.codeLength && line.data[start] == ',')start++;
+	SpecLexer lexer(line.data + start, line.codeLength - start, ",");
+
+	std::vector<uint16> values;
+	Token token;
+	while(lexer.next(token))values.push_back(toNumber(trim(token)));
+
+	if(values.size() < 2)throw jm::Exception("BIGFONT header incomplete.");
+	mBigfontCount = values[0];
+
+	uint32 ranges = values[1];
+	if(values.size() != 2 + 2 * (size_t)ranges)
+		throw jm::Exception("Number of escape ranges differs from BIGFONT header.");
+
+	for(uint32 a = 0; a < ranges; a++)
+	{
+		EscapeRange range;
+		uint16 first = values[2 + 2 * a];
+		uint16 last = values[3 + 2 * a];
+		if(first > last || last > 0xFF)
+			throw jm::Exception("Invalid escape range in BIGFONT header.");
+
+		range.first = (uint8)first;
+		range.last = (uint8)last;
+		mEscapes.push_back(range);
+	}
+
+	if(mVerbose)
+		report(Severity::kInfo, "Bigfont with "
+		       + jm::String::valueOf((int64)ranges)
+		       + " escape ranges.");
+}
+
+/*!
+ \brief This method evaluates the header of a shape. Each shape definition starts with it. There can
+ be many shapes / characters in one file.
+ */
+void Compiler::handleFirstLine(const ShpLine &line)
+{
+	SpecLexer lexer(line.data, line.codeLength, ",");
+
+	Token number;
+	Token count;
+	Token name;
+	lexer.next(number);
+	lexer.next(count);
+	lexer.next(name);
+
+	if(number.length == 0 || number.data[0] != '*')throw jm::Exception("* expected.");
+
+	uint16 shapeNumber;
+	if(equalsIgnoreCase(number, "*UNIFONT"))shapeNumber = 0;
+	else
+	{
+		number.data++;
+		number.length--;
+		shapeNumber = toNumber(number);
+	}
+
+	if(mVerbose)
+		report(Severity::kInfo, "Shape: " + toString(number)
+		       + ", Spec Bytes: " + toString(count)
+		       + ", Name: " + toString(name));
+
+	uint16 defBytes = toNumber(count);
+
+	// The name is stored encoded. ASCII characters are the same in Windows-1252.
+	bool ascii = true;
+	for(uint32 a = 0; a < name.length; a++)
+	{
+		if(name.data[a] >= 0x80)ascii = false;
+	}
+
+	if(ascii)mShapes.add(shapeNumber, defBytes, name.data, name.length);
+	else
+	{
+		jm::ByteArray cstring = toString(name).toCString(windowsCharset());
+		mShapes.add(shapeNumber, defBytes, (const uint8*)cstring.constData(), name.length);
+	}
+}
+
+/*!
+ \brief This method evaluates a specbyte line. The specbyte lines contain the geometry information
+ for a shape. A shape can contain several such lines.
+ */
+void Compiler::handleDefinitionLine(const ShpLine &line)
+{
+	if(mShapes.size() == 0)throw jm::Exception("Corrupt file. Shape header not found.");
+
+	uint32 current = mShapes.size() - 1;
+	uint16 defBytes = mShapes.defBytes(current);
+
+	SpecLexer lexer(line.data, line.codeLength, ",()");
+
+	Token token;
+	while(lexer.next(token))
+	{
+		token = trim(token);
+		if(token.length == 0)continue;
+
+		if(token.length > 4)
+		{
+			if(mShapes.position(current) + 1 >= defBytes)
+				throw jm::Exception("Too many spec bytes in shape: " + mShapes.name(current));
+
+			uint16 s = toSpecShort(token);
+			mShapes.append(current, (uint8)(s >> 8));
+			mShapes.append(current, (uint8)(s));
+		}
+		else
+		{
+			if(mShapes.position(current) >= defBytes)
+				throw jm::Exception("Too many spec bytes in shape: " + mShapes.name(current));
+
+			mShapes.append(current, toSpecByte(token));
+		}
+	}
+}
+
+/*!
+ \brief This method parses a compiled shape or its SpecBytes for errors in content. The font
+ information in shape 0 of a font is no command sequence and is checked separately.
+ */
+void Compiler::parse(uint32 index) const
+{
+	const uint8* buffer = mShapes.buffer(index);
+	uint32 defBytes = mShapes.defBytes(index);
+
+	SpecResult result;
+	if(mShapes.number(index) == 0)result = validateFontInfo(buffer, defBytes, mIsUnicode);
+	else if(mWide)result = validateSpec<true>(buffer, defBytes);
+	else result = validateSpec<false>(buffer, defBytes);
+
+	if(result.error != SpecError::kNone)
+		throw jm::Exception("In shape \""
+		                    + mShapes.name(index)
+		                    + "\": "
+		                    + specErrorMessage(result, mWide));
+}
+
+/*!
+ \brief This method checks if all names contain only numbers and capital letters.
+ */
+void Compiler::checkShapeName(uint32 index, std::vector<Diagnostic> &diagnostics) const
+{
+	const uint8* name = mShapes.encodedName(index);
+	for(uint32 a = 0; a < mShapes.nameLength(index); a++)
+	{
+		uint8 c = name[a];
+
+		if((c < '0' || c > '9') && (c < 'A' || c > 'Z'))
+		{
+			jm::String message = "In shape \""
+			                     + mShapes.name(index)
+			                     + "\": Characters of name should be upper case or numbers.";
+			diagnostics.push_back(Diagnostic(Severity::kWarning, mLine, message));
+			return;
+		}
+
+	}
+}
+
+/*!
+ \brief This method checks the shapes for potential errors.
+ */
+void Compiler::check()
+{
+	if(mShapes.size() == 0)throw jm::Exception("No shapes found.");
+	if(mShapeCount != mShapes.size())throw jm::Exception("Shape count differs from found shapes.");
+
+	if(mPool != nullptr && mShapes.size() >= 2 * kSectionShapes)checkParallel();
+	else checkShapes(0, mShapes.size(), mDiagnostics);
+
+	if(mFormat == ShxFormat::kBigfont)checkBigfont();
+
+	if(!mResolveReferences)return;
+
+	// Resolve the subshape references and check for cycles.
+	mGraph.build(mShapes, mWide);
+	mGraph.analyze(mShapes);
+
+	for(uint32 a = 0; a < mShapes.size(); a++)
+	{
+		if(mGraph.depth(a) > ShapeGraph::kMaxNesting)
+			report(Severity::kWarning, "In shape \""
+			       + mShapes.name(a)
+			       + "\": Subshapes are nested "
+			       + jm::String::valueOf((int64)mGraph.depth(a))
+			       + " levels deep.");
+	}
+}
+
+/*!
+ \brief This method checks the shape numbers of a bigfont. The high byte of each double byte
+ number must be a lead byte of an escape range. Single byte numbers, which are lead bytes, cannot
+ be reached.
+ */
+void Compiler::checkBigfont()
+{
+	bool lead[256] = {};
+	for(size_t a = 0; a < mEscapes.size(); a++)
+	{
+		for(uint32 b = mEscapes[a].first; b <= mEscapes[a].last; b++)lead[b] = true;
+	}
+
+	for(uint32 a = 0; a < mShapes.size(); a++)
+	{
+		uint16 number = mShapes.number(a);
+		if(number > 0xFF && !lead[number >> 8])
+			throw jm::Exception("In shape \""
+			                    + mShapes.name(a)
+			                    + "\": Shape number "
+			                    + jm::String::valueOf((int64)number)
+			                    + " is not in an escape range.");
+
+		if(number <= 0xFF && lead[number])
+			report(Severity::kWarning, "In shape \""
+			       + mShapes.name(a)
+			       + "\": Shape number "
+			       + jm::String::valueOf((int64)number)
+			       + " is a lead byte of an escape range.");
+	}
+
+	if(mBigfontCount != mShapes.size())
+		report(Severity::kWarning, "Shape count of BIGFONT header differs from found shapes.");
+}
+
+/*!
+ \brief This method replaces the subshape references by the spec bytes of the subshapes.
+ */
+void Compiler::flatten()
+{
+	uint32 failures = mGraph.flatten(mShapes, mWide);
+
+	if(failures > 0)
+		report(Severity::kWarning, jm::String::valueOf((int64)failures)
+		       + " Shapes could not be flattened, because they would become invalid.");
+}
+
+/*!
+ \brief This method checks the shapes in the range [begin, end) and throws an exception at the first
+ error.
+ */
+void Compiler::checkShapes(uint32 begin, uint32 end, std::vector<Diagnostic> &diagnostics) const
+{
+	for(uint32 a = begin; a < end; a++)
+	{
+		uint16 defBytes = mShapes.defBytes(a);
+
+		// Shapes from the cache were already checked, when they were compiled.
+		bool cached = mCache != nullptr && mCached[a] != 0;
+
+		// Check shape name for "non-fonts"
+		if(mShapes.number(0) != 0 && !cached)checkShapeName(a, diagnostics);
+
+		// Check that each shape ends with 0.
+		if(defBytes == 0 || mShapes.buffer(a)[defBytes - 1] != 0)
+			throw jm::Exception("In shape \"" + mShapes.name(a) + "\": Last spec byte must be 0.");
+
+		// Check if the specified number of bytes matches the actually specified spec bytes.
+		if(defBytes != mShapes.position(a))
+			throw jm::Exception("In shape \"" + mShapes.name(a) + "\": Wrong spec byte count.");
+
+		// Check that the shape numbers are ascending (and unique).
+		if(a > 0 && mShapes.number(a) <= mShapes.number(a - 1))
+			throw jm::Exception("In shape \""
+			                    + mShapes.name(a)
+			                    + "\": Number of shape is lower or equal than in shape before.");
+
+		if(!cached)parse(a);
+	}
+}
+
+/*!
+ \brief This method checks the shapes in sections on the thread pool. The messages of the sections
+ are merged in order, so the result is the same as of a serial check.
+ */
+void Compiler::checkParallel()
+{
+	struct Section
+	{
+		uint32 begin;
+		uint32 end;
+		bool failed;
+		jm::String error;
+		std::vector<Diagnostic> diagnostics;
+	};
+
+	uint32 count = mPool->size() * kTasksPerThread;
+	uint32 length = mShapes.size() / count;
+	if(length < kSectionShapes)length = kSectionShapes;
+
+	std::vector<Section> sections;
+	for(uint32 begin = 0; begin < mShapes.size(); begin += length)
+	{
+		Section section;
+		section.begin = begin;
+		section.end = std::min(begin + length, mShapes.size());
+		section.failed = false;
+		sections.push_back(section);
+	}
+
+	TaskGroup group;
+	for(size_t a = 0; a < sections.size(); a++)
+	{
+		Section* section = &sections[a];
+		mPool->submit([this, section]
+		{
+			TraceSpan span(mTrace, "check section", "task");
+			try
+			{
+				checkShapes(section->begin, section->end, section->diagnostics);
+			}
+			catch(jm::Exception &e)
+			{
+				section->failed = true;
+				section->error = e.errorMessage();
+			}
+		}, &group);
+	}
+	mPool->wait(group);
+
+	// The first error in order stops the compilation like in the serial case.
+	for(size_t a = 0; a < sections.size(); a++)
+	{
+		const Section &section = sections[a];
+		mDiagnostics.insert(mDiagnostics.end(),
+		                    section.diagnostics.begin(),
+		                    section.diagnostics.end());
+		if(section.failed)throw jm::Exception(section.error);
+	}
+}
+
+/*!
+ \brief This method writes the SHX file in Unicode format.
+ */
+void Compiler::writeUnicodeSHX()
+{
+	if(mVerbose)report(Severity::kInfo, "Write file in UNICODE file format.");
+
+	mImage.build(mFormat, mShapes);
+
+	if(mVerbose)
+		report(Severity::kInfo, jm::String::valueOf((int64)mShapes.size()) + " Shapes compiled.");
+}
+
+
+/*!
+ \brief This method writes the SHX file in normal format.
+ */
+void Compiler::writeNormalSHX()
+{
+	if(mVerbose)report(Severity::kInfo, "Write file in NORMAL file format.");
+
+	mImage.build(mFormat, mShapes);
+
+	if(mVerbose)
+		report(Severity::kInfo, jm::String::valueOf((int64)mShapes.size()) + " Shapes compiled.");
+}
+
+/*!
+ \brief This method writes the SHX file in bigfont format.
+ */
+void Compiler::writeBigfontSHX()
+{
+	if(mVerbose)report(Severity::kInfo, "Write file in BIGFONT file format.");
+
+	mImage.build(mFormat, mShapes, mEscapes);
+
+	if(mVerbose)
+		report(Severity::kInfo, jm::String::valueOf((int64)mShapes.size()) + " Shapes compiled.");
+}
+
+/*!
+ \brief Compiles the loaded file and turns errors into diagnostics.
+ */
+bool Compiler::run()
+{
+	try
+	{
+		process();
+	}
+	catch(jm::Exception &e)
+	{
+		report(Severity::kError, e.errorMessage());
+		mImage.allocate(0);
+		return false;
+	}
+	return true;
+}
+
+/*!
+ \brief This method controls the compilation as a whole.
+ */
+void Compiler::process()
+{
+	Clock::time_point start = Clock::now();
+	{
+		TraceSpan span(mTrace, "tokenize", "phase");
+		if(mPool != nullptr && mReader.size() >= kParallelSize)readParallel();
+		else read();
+	}
+	mTimes.tokenize = seconds(start);
+
+	// The following messages do not refer to a single line.
+	mLine = 0;
+
+	start = Clock::now();
+	{
+		TraceSpan span(mTrace, "check", "phase");
+		check();
+	}
+	mTimes.check = seconds(start);
+
+	// The cache holds the shapes as they are in the SHP file.
+	if(mCache != nullptr)
+	{
+		if(mVerbose)
+			report(Severity::kInfo, jm::String::valueOf((int64)cachedShapes())
+			       + " of " + jm::String::valueOf((int64)mShapes.size())
+			       + " Shapes taken from cache.");
+
+		mCache->clear();
+		for(uint32 a = 0; a < mShapes.size(); a++)mCache->add(mHashes[a], mShapes, a);
+	}
+
+	if(mFlatten && mResolveReferences)
+	{
+		TraceSpan span(mTrace, "flatten", "phase");
+		flatten();
+	}
+
+	if(mOptimize)
+	{
+		TraceSpan span(mTrace, "optimize", "phase");
+		optimize();
+	}
+
+	if(mDeduplicate && mResolveReferences)
+	{
+		TraceSpan span(mTrace, "deduplicate", "phase");
+		deduplicate();
+	}
+
+	start = Clock::now();
+	{
+		TraceSpan span(mTrace, "write", "phase");
+		if(mFormat == ShxFormat::kBigfont)writeBigfontSHX();
+		else if(mIsUnicode)writeUnicodeSHX();
+		else writeNormalSHX();
+	}
+	mTimes.write = seconds(start);
+}
+
+/*!
+ \brief This method optimizes the spec bytes of all shapes and reports the savings.
+ */
+void Compiler::optimize()
+{
+	uint32 before = 0;
+	mShapes.transform([this, &before](uint32 index, std::vector<uint8> &bytes)
+	{
+		// The font information contains no commands.
+		if(mShapes.number(index) == 0)return;
+
+		before += (uint32)bytes.size();
+		if(mWide)mSavedBytes += Optimizer<true>::optimize(bytes);
+		else mSavedBytes += Optimizer<false>::optimize(bytes);
+	});
+
+	report(Severity::kInfo, "Optimization saved "
+	       + jm::String::valueOf((int64)mSavedBytes)
+	       + " of "
+	       + jm::String::valueOf((int64)before)
+	       + " spec bytes.");
+}
+
+/*!
+ \brief This method moves repeated runs of commands into new shapes and reports the savings.
+ */
+void Compiler::deduplicate()
+{
+	Deduplicator deduplicator(mWide);
+	if(mFormat == ShxFormat::kBigfont)deduplicator.setEscapeRanges(mEscapes);
+	uint32 saved = deduplicator.run(mShapes);
+
+	if(deduplicator.exhausted())
+		report(Severity::kWarning, "No free shape number left for further subshapes.");
+
+	report(Severity::kInfo, jm::String::valueOf((int64)deduplicator.subshapes())
+	       + " Subshapes extracted, "
+	       + jm::String::valueOf((int64)saved)
+	       + " bytes saved.");
+}
+
+/*!
+ \brief This method traverses the file and reads all shapes.
+ */
+void Compiler::read()
+{
+	// Each spec byte takes at least two characters in the SHP file.
+	mShapes.reserve((uint32)(mReader.size() / 2));
+
+	ShpLine line;
+	while(mReader.nextLine(line))
+	{
+		mLine++;
+
+		if(line.length > 128)report(Severity::kWarning, "Line is longer then 128 Bytes.");
+
+		if(line.codeLength > 0)
+		{
+			if(line.data[0] == '*')
+			{
+				// The header of a bigfont is no shape.
+				if(startsWith(line, "*BIGFONT"))
+				{
+					if(mFiletype.size() == 0)detectFiletype(line);
+					handleBigfontLine(line);
+					continue;
+				}
+
+				// First line in the SHP file determines what it is. The chunks of a large file get
+				// the file type from the beginning of the file.
+				if(mShapeCount == 0 && mFiletype.size() == 0)detectFiletype(line);
+				mShapeCount++;
+				if(mCache != nullptr && restoreShape(line))continue;
+				handleFirstLine(line);
+			}
+			else handleDefinitionLine(line);
+		}
+	}
+}
+
+/*!
+ \brief Determines the file type from the first shape header.
+ */
+void Compiler::detectFiletype(const ShpLine &line)
+{
+	if(startsWith(line, "*UNIFONT,"))mFormat = ShxFormat::kUnifont;
+	else if(startsWith(line, "*BIGFONT"))mFormat = ShxFormat::kBigfont;
+	else if(startsWith(line, "*0,"))mFormat = ShxFormat::kShapes11;
+	else mFormat = ShxFormat::kShapes10;
+
+	mFiletype = shpc::filetype(mFormat);
+	mIsUnicode = mFormat == ShxFormat::kUnifont;
+	mWide = wideSubshapes(mFormat);
+}
+
+/*!
+ \brief Takes the shape, which starts with the header line, from the cache, if its source text did
+ not change. The lines of the shape are skipped then. Otherwise the reader is set back to the line
+ after the header.
+ */
+bool Compiler::restoreShape(const ShpLine &header)
+{
+	const uint8* data = mReader.data();
+	size_t position = mReader.position();
+
+	// The source text of the shape ends before the next header.
+	size_t end = mReader.size();
+	uint32 lines = 0;
+	ShpLine line;
+	while(mReader.nextLine(line))
+	{
+		if(line.codeLength > 0 && line.data[0] == '*')
+		{
+			end = line.data - data;
+			break;
+		}
+		lines++;
+	}
+
+	uint64 key = mWide ? hash(header.data, end - (header.data - data), kUnicodeSeed)
+	             : hash(header.data, end - (header.data - data));
+	mHashes.push_back(key);
+
+	if(mCache->restore(key, mShapes))
+	{
+		mCached.push_back(1);
+		mLine += lines;
+		mReader.seek(end);
+		return true;
+	}
+
+	mCached.push_back(0);
+	mReader.seek(position);
+	return false;
+}
+
+/*!
+ \brief Reads one chunk of a large file. The error is added to the diagnostics, because tasks must
+ not throw exceptions.
+ */
+void Compiler::readChunk()
+{
+	TraceSpan span(mTrace, "tokenize chunk", "task");
+	try
+	{
+		read();
+	}
+	catch(jm::Exception &e)
+	{
+		report(Severity::kError, e.errorMessage());
+	}
+}
+
+/*!
+ \brief This method splits the file at the shape headers into chunks. Each chunk is read by its own
+ compiler object on the thread pool. The shapes and messages of the chunks are merged in order.
+ */
+void Compiler::readParallel()
+{
+	const uint8* data = mReader.data();
+	size_t size = mReader.size();
+
+	// The first shape header determines the file type of all chunks.
+	ShpLine line;
+	while(mReader.nextLine(line))
+	{
+		if(line.codeLength > 0 && line.data[0] == '*')
+		{
+			detectFiletype(line);
+			break;
+		}
+	}
+
+	size_t length = size / (mPool->size() * kTasksPerThread);
+	if(length < kChunkSize)length = kChunkSize;
+
+	// A chunk ends before a line, which starts with '*'. Comments end at the line end, so each such
+	// line is a shape header.
+	std::vector<size_t> bounds;
+	bounds.push_back(0);
+	size_t position = length;
+	while(position < size)
+	{
+		const uint8* star = (const uint8*)std::memchr(data + position, '*', size - position);
+		if(star == nullptr)break;
+
+		position = star - data;
+		if(data[position - 1] == '\n' || data[position - 1] == '\r')
+		{
+			bounds.push_back(position);
+			position += length;
+		}
+		else position++;
+	}
+	bounds.push_back(size);
+
+	std::vector<Compiler*> chunks;
+	TaskGroup group;
+	for(size_t a = 0; a + 1 < bounds.size(); a++)
+	{
+		Compiler* chunk = new Compiler();
+		chunk->mVerbose = mVerbose;
+		chunk->mCache = mCache;
+		chunk->mTrace = mTrace;
+		chunk->mFiletype = mFiletype;
+		chunk->mFormat = mFormat;
+		chunk->mIsUnicode = mIsUnicode;
+		chunk->mWide = mWide;
+		chunk->mReader.load(data + bounds[a], bounds[a + 1] - bounds[a]);
+		chunks.push_back(chunk);
+		mPool->submit([chunk] {chunk->readChunk();}, &group);
+	}
+	mPool->wait(group);
+
+	uint32 arenaSize = 0;
+	for(size_t a = 0; a < chunks.size(); a++)arenaSize += chunks[a]->mShapes.arenaSize();
+	mShapes.reserve(arenaSize);
+
+	// The line numbers of the chunks start with 1 and are shifted by the lines before.
+	try
+	{
+		for(size_t a = 0; a < chunks.size(); a++)
+		{
+			Compiler* chunk = chunks[a];
+
+			for(size_t b = 0; b < chunk->mDiagnostics.size(); b++)
+			{
+				const Diagnostic &diagnostic = chunk->mDiagnostics[b];
+				uint32 line = diagnostic.line > 0 ? mLine + diagnostic.line : 0;
+
+				if(diagnostic.severity == Severity::kError)
+				{
+					mLine = line;
+					throw jm::Exception(diagnostic.message);
+				}
+				mDiagnostics.push_back(Diagnostic(diagnostic.severity, line, diagnostic.message));
+			}
+
+			// Only the first chunk may contain the BIGFONT header.
+			if(chunk->mBigfontHeader)
+			{
+				if(a > 0)throw jm::Exception("BIGFONT header must be the first line.");
+				mEscapes = chunk->mEscapes;
+				mBigfontCount = chunk->mBigfontCount;
+				mBigfontHeader = true;
+			}
+
+			mShapes.merge(chunk->mShapes);
+			mHashes.insert(mHashes.end(), chunk->mHashes.begin(), chunk->mHashes.end());
+			mCached.insert(mCached.end(), chunk->mCached.begin(), chunk->mCached.end());
+			mShapeCount += chunk->mShapeCount;
+			mLine += chunk->mLine;
+		}
+	}
+	catch(...)
+	{
+		for(size_t a = 0; a < chunks.size(); a++)delete chunks[a];
+		throw;
+	}
+
+	for(size_t a = 0; a < chunks.size(); a++)delete chunks[a];
+}
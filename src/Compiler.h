@@ -0,0 +1,391 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Compiler.h
+// Application: Shape File Compiler
+// Purpose:     Reentrant compiler for SHP files
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_Compiler_h
+#define shpc_Compiler_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+#include "ShapeCache.h"
+#include "ShapeGraph.h"
+#include "ShapeTable.h"
+#include "ShpReader.h"
+#include "ShxImage.h"
+#include "SpecLexer.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief Severity of a diagnostic message.
+	 */
+	enum class Severity
+	{
+		kInfo,
+		kWarning,
+		kError
+	};
+
+	/*!
+	 \brief A message of the compiler, e.g. an error in the SHP file.
+	 */
+	struct Diagnostic
+	{
+		// The severity of the message.
+		Severity severity;
+
+		// The line in the SHP file the message refers to, starting with 1. 0 if the message does not
+		// refer to a line.
+		uint32 line;
+
+		// The message itself.
+		jm::String message;
+
+		Diagnostic(Severity severity, uint32 line, const jm::String &message)
+		{
+			this->severity = severity;
+			this->line = line;
+			this->message = message;
+		}
+	};
+
+	/*!
+	 \brief Duration of the phases of a compilation in seconds.
+	 */
+	struct PhaseTimes
+	{
+		// Reading the SHP file into memory. 0 if the content was passed to the compiler.
+		double read;
+
+		// Splitting the lines and tokenizing the spec bytes into the shape table.
+		double tokenize;
+
+		// Checking the shapes, including the parsing of the spec bytes.
+		double check;
+
+		// Writing the SHX image.
+		double write;
+
+		PhaseTimes()
+		{
+			read = 0;
+			tokenize = 0;
+			check = 0;
+			write = 0;
+		}
+	};
+
+	/*!
+	 \brief Returns the Windows-1252 charset, with which all strings in SHX files are encoded.
+	 */
+	jm::Charset* windowsCharset();
+
+	/*!
+	 \brief The compiler translates the content of a SHP file into the content of a SHX file. All
+	 state of a compilation is held by the compiler object, so several compilers can run in parallel
+	 in different threads. A single compiler object must not be used by several threads at once.
+	 jm::System::init() must be called once before the first compilation.
+	 */
+	class Compiler
+	{
+		public:
+
+			Compiler();
+
+			/*!
+			 \brief Status whether detailed information is added to the diagnostics.
+			 */
+			void setVerbose(bool verbose);
+
+			/*!
+			 \brief Sets the thread pool for large files. A large file is split at the shape headers
+			 into chunks, which are read and checked in parallel. If nullptr (default), all files are
+			 compiled in the calling thread. The pool must exist during the compilation.
+			 */
+			void setThreadPool(ThreadPool* pool);
+
+			/*!
+			 \brief Sets the trace, in which the phases of the compilation are recorded. If nullptr
+			 (default), nothing is recorded.
+			 */
+			void setTrace(Trace* trace);
+
+			/*!
+			 \brief Sets the cache for incremental compilation. Shapes, whose source text did not
+			 change, are taken from the cache without reading and checking their spec bytes again, so
+			 the diagnostics only refer to changed shapes. After a successful compilation the cache
+			 contains the shapes of the file. If nullptr (default), no cache is used.
+			 */
+			void setCache(ShapeCache* cache);
+
+			/*!
+			 \brief Status whether the subshape references are replaced by the spec bytes of the
+			 subshapes before the SHX file is written. For targets, where calling subshapes is slow.
+			 */
+			void setFlatten(bool flatten);
+
+			/*!
+			 \brief Status whether the spec bytes are optimized by a peephole optimizer before the
+			 SHX file is written. The rendering of the shapes stays the same.
+			 */
+			void setOptimize(bool optimize);
+
+			/*!
+			 \brief Status whether runs of commands, which are repeated in several shapes, are moved
+			 into new shapes and referenced as subshapes. This makes large fonts smaller.
+			 */
+			void setDeduplicate(bool deduplicate);
+
+			/*!
+			 \brief Status whether the subshape references are resolved. If false, references to
+			 shapes of other fonts are allowed, e.g. if the font is merged with others later. Then
+			 the subshapes cannot be flattened or deduplicated. Default: true.
+			 */
+			void setResolveReferences(bool resolve);
+
+			/*!
+			 \brief Returns the number of spec bytes saved by the optimizer in the last compilation.
+			 */
+			uint32 savedBytes() const;
+
+			/*!
+			 \brief Returns the number of shapes of the last compilation taken from the cache.
+			 */
+			uint32 cachedShapes() const;
+
+			/*!
+			 \brief Compiles the SHP file content. The data is not copied and must stay valid during
+			 the call.
+			 \return true on success. On failure the diagnostics contain at least one error.
+			 */
+			bool compile(const uint8* data, size_t length);
+
+			/*!
+			 \brief Reads and compiles the SHP file.
+			 */
+			bool compile(jm::File* file);
+
+			/*!
+			 \brief Returns the compiled SHX file. Only valid after successful compilation.
+			 */
+			const ShxImage& image() const;
+
+			/*!
+			 \brief Returns all messages of the last compilation in the order of their appearance.
+			 */
+			const std::vector<Diagnostic>& diagnostics() const;
+
+			/*!
+			 \brief Returns true, if the last compilation reported an error.
+			 */
+			bool hasErrors() const;
+
+			/*!
+			 \brief Returns the number of bytes of the SHP file of the last compilation.
+			 */
+			size_t inputSize() const;
+
+			/*!
+			 \brief Returns the shapes of the last compilation.
+			 */
+			const ShapeTable& shapes() const;
+
+			/*!
+			 \brief Returns the graph of the subshape references of the last compilation. The graph
+			 refers to the shapes before flattening.
+			 */
+			const ShapeGraph& graph() const;
+
+			/*!
+			 \brief Returns the duration of the phases of the last compilation.
+			 */
+			const PhaseTimes& times() const;
+
+			/*!
+			 \brief Returns true, if the font is in Unicode format.
+			 */
+			bool isUnicode() const;
+
+			/*!
+			 \brief Returns the file type of the SHX file.
+			 */
+			ShxFormat format() const;
+
+			/*!
+			 \brief Returns the escape ranges of a bigfont.
+			 */
+			const std::vector<EscapeRange>& escapeRanges() const;
+
+			/*!
+			 \brief Returns the string with which the SHX file begins.
+			 */
+			const jm::String& filetype() const;
+
+		private:
+
+			// Status whether detailed information is reported.
+			bool mVerbose;
+
+			// The pool for parallel compilation or nullptr.
+			ThreadPool* mPool;
+
+			// The trace or nullptr.
+			Trace* mTrace;
+
+			// The cache for incremental compilation or nullptr.
+			ShapeCache* mCache;
+
+			// Status whether the subshapes are flattened.
+			bool mFlatten;
+
+			// Status whether the spec bytes are optimized.
+			bool mOptimize;
+
+			// Status whether repeated runs are moved into subshapes.
+			bool mDeduplicate;
+
+			// Status whether the subshape references are resolved.
+			bool mResolveReferences;
+
+			// The number of spec bytes saved by the optimizer.
+			uint32 mSavedBytes;
+
+			// The hashes of the source text of the shapes, if a cache is used.
+			std::vector<uint64> mHashes;
+
+			// Status for each shape whether it was taken from the cache.
+			std::vector<uint8> mCached;
+
+			// The current line during reading, starting with 1.
+			uint32 mLine;
+
+			// String designation about the file type. This is also the string with which the file
+			// begins on the disk.
+			jm::String mFiletype;
+
+			// The file type of the SHX file.
+			ShxFormat mFormat;
+
+			// There are two variants of how the shapes are stored in the file. One is Unicode and the
+			// other is "normal". With Unicode all shapes are packed together. With "normal" first
+			// header data for all shapes are written and then the shape descriptions.
+			bool mIsUnicode;
+
+			// Status whether the subshape numbers take two bytes, in unifonts and bigfonts.
+			bool mWide;
+
+			// The escape ranges of the BIGFONT header.
+			std::vector<EscapeRange> mEscapes;
+
+			// The number of shapes given in the BIGFONT header.
+			uint32 mBigfontCount;
+
+			// Status whether the BIGFONT header was read.
+			bool mBigfontHeader;
+
+			// Table with all shapes. The shape that is currently being compiled is always the last
+			// one.
+			ShapeTable mShapes;
+
+			// The subshape references of the shapes.
+			ShapeGraph mGraph;
+
+			// Counts the shape definition lines during read-in.
+			uint32 mShapeCount;
+
+			// The compiled SHX file.
+			ShxImage mImage;
+
+			// The messages of the compilation.
+			std::vector<Diagnostic> mDiagnostics;
+
+			// The reader of the current compilation.
+			ShpReader mReader;
+
+			// The duration of the phases.
+			PhaseTimes mTimes;
+
+			void reset();
+
+			void report(Severity severity, const jm::String &message);
+
+			bool run();
+
+			void process();
+
+			void read();
+
+			void readChunk();
+
+			void readParallel();
+
+			void detectFiletype(const ShpLine &line);
+
+			bool restoreShape(const ShpLine &header);
+
+			void handleBigfontLine(const ShpLine &line);
+
+			void handleFirstLine(const ShpLine &line);
+
+			void handleDefinitionLine(const ShpLine &line);
+
+			void parse(uint32 index) const;
+
+			void checkShapeName(uint32 index, std::vector<Diagnostic> &diagnostics) const;
+
+			void checkShapes(uint32 begin, uint32 end, std::vector<Diagnostic> &diagnostics) const;
+
+			void checkParallel();
+
+			void check();
+
+			void checkBigfont();
+
+			void flatten();
+
+			void optimize();
+
+			void deduplicate();
+
+			void writeUnicodeSHX();
+
+			void writeNormalSHX();
+
+			void writeBigfontSHX();
+	};
+
+}
+
+#endif
@@ -0,0 +1,428 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Deduplicator.cpp
+// Application: Shape File Compiler
+// Purpose:     Extraction of repeated runs into subshapes
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "Deduplicator.h"
+#include "SpecValidator.h"
+
+using namespace shpc;
+
+const uint32 Deduplicator::kRunLengths[] = {16, 12, 8, 6, 4, 3, 2, 0};
+
+// The base of the polynomial hash of the runs.
+static const uint64 kHashBase = 0x100000001B3ULL;
+
+// The bytes of a new shape besides its spec bytes: the entry in the index or the header of the
+// shape, the name "SUB<number>" with terminating zero and the final 0 of the spec bytes.
+static const uint32 kShapeCost = 4 + 9 + 1;
+
+Deduplicator::Deduplicator(bool unicode)
+{
+	mUnicode = unicode;
+	mBigfont = false;
+	mNextNumber = 0;
+	mLowestNumber = 1;
+	mSaved = 0;
+	mExhausted = false;
+}
+
+void Deduplicator::setEscapeRanges(const std::vector<EscapeRange> &ranges)
+{
+	mBigfont = true;
+	mLeadBytes.assign(256, 0);
+	for(size_t a = 0; a < ranges.size(); a++)
+	{
+		for(uint32 b = ranges[a].first; b <= ranges[a].last; b++)mLeadBytes[b] = 1;
+	}
+}
+
+uint32 Deduplicator::subshapes() const
+{
+	return (uint32)mExtractions.size();
+}
+
+bool Deduplicator::exhausted() const
+{
+	return mExhausted;
+}
+
+/*!
+ \brief Splits the shapes into commands and computes the hashes and stack depths.
+ */
+void Deduplicator::prepare(const ShapeTable &shapes)
+{
+	mBytes.clear();
+	mStart.clear();
+	mLimit.clear();
+	mDepth.clear();
+	mConditional.clear();
+	mFirst.clear();
+	mExtractions.clear();
+	mSaved = 0;
+	mExhausted = false;
+
+	mNumbers.assign(0x10000, 0);
+	for(uint32 a = 0; a < shapes.size(); a++)mNumbers[shapes.number(a)] = 1;
+	if(mBigfont)
+	{
+		// From the highest to the lowest lead byte, the numbers of other bytes are skipped.
+		mNextNumber = 0;
+		mLowestNumber = 0x10000;
+		for(uint32 a = 0x01; a <= 0xFF; a++)
+		{
+			if(mLeadBytes[a] == 0)continue;
+			if(mLowestNumber == 0x10000)mLowestNumber = a << 8;
+			mNextNumber = (a << 8) | 0xFF;
+		}
+	}
+	else if(mUnicode)
+	{
+		// Only the private use area, the other numbers are characters.
+		mNextNumber = 0xF8FF;
+		mLowestNumber = 0xE000;
+	}
+	else if(shapes.size() > 0 && shapes.number(0) == 0)
+	{
+		// In text fonts all printable codes are characters, which are typed. Only the control
+		// codes and DEL are left.
+		for(uint32 a = 0x20; a <= 0xFF; a++)
+		{
+			if(a != 0x7F)mNumbers[a] = 1;
+		}
+		mNextNumber = 0x7F;
+		mLowestNumber = 1;
+	}
+	else
+	{
+		mNextNumber = 0xFF;
+		mLowestNumber = 1;
+	}
+
+	for(uint32 a = 0; a < shapes.size(); a++)
+	{
+		mFirst.push_back((uint32)mStart.size());
+
+		// The font information contains no commands.
+		if(shapes.number(a) == 0)continue;
+
+		const uint8* bytes = shapes.buffer(a);
+		uint32 length = shapes.defBytes(a);
+		uint32 offset = (uint32)mBytes.size();
+		uint32 first = (uint32)mStart.size();
+		mBytes.insert(mBytes.end(), bytes, bytes + length);
+
+		int32 depth = 0;
+		bool afterDoNext = false;
+		uint32 position = 0;
+		while(position < length)
+		{
+			mStart.push_back(offset + position);
+			mDepth.push_back(depth);
+			mConditional.push_back(afterDoNext ? 1 : 0);
+
+			uint8 code = bytes[position];
+			if(code == 5)depth++;
+			else if(code == 6)depth--;
+			afterDoNext = code == 14;
+
+			position += commandSize(bytes, position, mUnicode);
+		}
+
+		// The final 0 is the last command.
+		for(uint32 b = first; b < mStart.size(); b++)mLimit.push_back((uint32)mStart.size() - 1);
+	}
+	mFirst.push_back((uint32)mStart.size());
+
+	// A sentinel behind the last command
+	mStart.push_back((uint32)mBytes.size());
+
+	mHash.resize(mBytes.size() + 1);
+	mHash[0] = 0;
+	for(size_t a = 0; a < mBytes.size(); a++)mHash[a + 1] = mHash[a] * kHashBase + mBytes[a] + 1;
+
+	mPower.resize(0x10000);
+	mPower[0] = 1;
+	for(size_t a = 1; a < mPower.size(); a++)mPower[a] = mPower[a - 1] * kHashBase;
+
+	mReplace.assign(mLimit.size(), 0);
+	mUsed.assign(mLimit.size(), 0);
+}
+
+uint64 Deduplicator::hash(uint32 command, uint32 length) const
+{
+	uint32 begin = mStart[command];
+	uint32 end = mStart[command + length];
+	return mHash[end] - mHash[begin] * mPower[end - begin];
+}
+
+/*!
+ \brief Returns the number of bytes of the run.
+ */
+uint32 Deduplicator::size(uint32 command, uint32 length) const
+{
+	return mStart[command + length] - mStart[command];
+}
+
+/*!
+ \brief Returns true, if the run may be extracted.
+ */
+bool Deduplicator::isCandidate(uint32 command, uint32 length) const
+{
+	uint32 end = command + length;
+	if(end > mLimit[command])return false;
+	if(mConditional[command] != 0 || mConditional[end] != 0)return false;
+
+	// A reference must be shorter than the run.
+	if(size(command, length) <= (mUnicode ? 3u : 2u))return false;
+
+	// The position stack must be balanced and must not drop below its depth at the start.
+	int32 depth = mDepth[command];
+	if(mDepth[end] != depth)return false;
+	for(uint32 a = command; a < end; a++)
+	{
+		if(mUsed[a] != 0 || mDepth[a] < depth)return false;
+	}
+	return true;
+}
+
+bool Deduplicator::equals(uint32 a, uint32 b, uint32 length) const
+{
+	uint32 bytes = size(a, length);
+	if(bytes != size(b, length))return false;
+	return std::memcmp(mBytes.data() + mStart[a], mBytes.data() + mStart[b], bytes) == 0;
+}
+
+/*!
+ \brief Returns the number of bytes saved by moving a run into a new shape.
+ */
+int32 Deduplicator::gain(uint32 occurrences, uint32 bytes) const
+{
+	int32 reference = mUnicode ? 3 : 2;
+	return (int32)occurrences * ((int32)bytes - reference) - (int32)(bytes + kShapeCost);
+}
+
+/*!
+ \brief Determines an unused shape number, which can be referenced. In normal fonts, 10 is left out,
+ because it is the line feed, and text fonts take only control codes and DEL. In Unicode fonts
+ only numbers of the private use area are taken, in bigfonts only numbers with a lead byte.
+ */
+bool Deduplicator::nextNumber(uint16 &number)
+{
+	while(mNextNumber > 0 && mNextNumber >= mLowestNumber)
+	{
+		uint32 candidate = mNextNumber--;
+		if(mNumbers[candidate] != 0 || (!mUnicode && candidate == 10))continue;
+		if(mBigfont && mLeadBytes[candidate >> 8] == 0)continue;
+
+		mNumbers[candidate] = 1;
+		number = (uint16)candidate;
+		return true;
+	}
+	return false;
+}
+
+/*!
+ \brief Extracts the repeated runs with the given number of commands.
+ */
+void Deduplicator::search(uint32 length)
+{
+	uint32 count = (uint32)mLimit.size();
+
+	std::vector<std::pair<uint64, uint32> > runs;
+	for(uint32 a = 0; a < count; a++)
+	{
+		if(isCandidate(a, length))runs.push_back(std::make_pair(hash(a, length), a));
+	}
+	std::sort(runs.begin(), runs.end());
+
+	// Groups of runs with the same hash, ordered by the estimated gain.
+	struct Group
+	{
+		int32 gain;
+		uint32 begin;
+		uint32 end;
+
+		bool operator<(const Group &other) const
+		{
+			return gain > other.gain;
+		}
+	};
+
+	std::vector<Group> groups;
+	for(uint32 begin = 0; begin < runs.size();)
+	{
+		uint32 end = begin + 1;
+		while(end < runs.size() && runs[end].first == runs[begin].first)end++;
+
+		Group group;
+		group.gain = gain(end - begin, size(runs[begin].second, length));
+		group.begin = begin;
+		group.end = end;
+		if(end - begin > 1 && group.gain > 0)groups.push_back(group);
+
+		begin = end;
+	}
+	std::sort(groups.begin(), groups.end());
+
+	std::vector<uint32> occurrences;
+	for(size_t g = 0; g < groups.size(); g++)
+	{
+		const Group &group = groups[g];
+		uint32 first = runs[group.begin].second;
+
+		// The runs of the group are ordered by position, so overlapping runs of one shape are
+		// skipped by the marks of the previous run.
+		occurrences.clear();
+		for(uint32 r = group.begin; r < group.end; r++)
+		{
+			uint32 command = runs[r].second;
+			if(!equals(first, command, length) || !isCandidate(command, length))continue;
+
+			occurrences.push_back(command);
+			for(uint32 a = command; a < command + length; a++)mUsed[a] = 1;
+		}
+
+		Extraction extraction;
+		int32 saved = gain((uint32)occurrences.size(), size(first, length));
+		bool extract = occurrences.size() >= 2 && saved > 0;
+		if(extract && !nextNumber(extraction.number))
+		{
+			mExhausted = true;
+			extract = false;
+		}
+		if(!extract)
+		{
+			for(size_t o = 0; o < occurrences.size(); o++)
+			{
+				for(uint32 a = occurrences[o]; a < occurrences[o] + length; a++)mUsed[a] = 0;
+			}
+			continue;
+		}
+
+		extraction.command = occurrences[0];
+		extraction.length = length;
+		mExtractions.push_back(extraction);
+		mSaved += saved;
+
+		for(size_t o = 0; o < occurrences.size(); o++)
+			mReplace[occurrences[o]] = (uint32)mExtractions.size();
+	}
+}
+
+/*!
+ \brief Creates the new table with the changed shapes and the new shapes in the order of the
+ numbers.
+ */
+void Deduplicator::rebuild(ShapeTable &shapes) const
+{
+	std::vector<uint32> order(mExtractions.size());
+	for(uint32 a = 0; a < order.size(); a++)order[a] = a;
+	std::sort(order.begin(), order.end(), [this](uint32 a, uint32 b)
+	{
+		return mExtractions[a].number < mExtractions[b].number;
+	});
+
+	ShapeTable table;
+	table.reserve(shapes.arenaSize());
+
+	std::vector<uint8> bytes;
+	size_t next = 0;
+	for(uint32 a = 0; a <= shapes.size(); a++)
+	{
+		// The new shapes before the shape
+		while(next < order.size() && (a == shapes.size()
+		                              || mExtractions[order[next]].number < shapes.number(a)))
+		{
+			const Extraction &extraction = mExtractions[order[next++]];
+			const uint8* run = mBytes.data() + mStart[extraction.command];
+
+			bytes.assign(run, run + size(extraction.command, extraction.length));
+			bytes.push_back(0);
+
+			std::string name = "SUB" + std::to_string(extraction.number);
+			uint32 index = table.add(extraction.number,
+			                         (uint16)bytes.size(),
+			                         (const uint8*)name.data(),
+			                         (uint32)name.size());
+			for(size_t b = 0; b < bytes.size(); b++)table.append(index, bytes[b]);
+		}
+		if(a == shapes.size())break;
+
+		bytes.clear();
+		if(shapes.number(a) == 0)
+		{
+			bytes.assign(shapes.buffer(a), shapes.buffer(a) + shapes.defBytes(a));
+		}
+		else
+		{
+			for(uint32 command = mFirst[a]; command < mFirst[a + 1];)
+			{
+				if(mReplace[command] != 0)
+				{
+					const Extraction &extraction = mExtractions[mReplace[command] - 1];
+					bytes.push_back(7);
+					if(mUnicode)bytes.push_back((uint8)(extraction.number >> 8));
+					bytes.push_back((uint8)extraction.number);
+					command += extraction.length;
+				}
+				else
+				{
+					const uint8* run = mBytes.data() + mStart[command];
+					bytes.insert(bytes.end(), run, run + size(command, 1));
+					command++;
+				}
+			}
+		}
+
+		uint32 index = table.add(shapes.number(a),
+		                         (uint16)bytes.size(),
+		                         shapes.encodedName(a),
+		                         shapes.nameLength(a));
+		for(size_t b = 0; b < bytes.size(); b++)table.append(index, bytes[b]);
+	}
+
+	shapes = std::move(table);
+}
+
+uint32 Deduplicator::run(ShapeTable &shapes)
+{
+	prepare(shapes);
+
+	for(uint32 a = 0; kRunLengths[a] > 0; a++)search(kRunLengths[a]);
+
+	if(mExtractions.size() > 0)rebuild(shapes);
+
+	return (uint32)mSaved;
+}
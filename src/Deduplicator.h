@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Deduplicator.h
+// Application: Shape File Compiler
+// Purpose:     Extraction of repeated runs into subshapes
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_Deduplicator_h
+#define shpc_Deduplicator_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+#include "ShapeTable.h"
+#include "ShxImage.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The deduplicator finds runs of commands, which are repeated in several shapes, e.g. the
+	 accents of letters or the radicals of CJK characters. Each run, which saves bytes, is moved into
+	 a new shape and all its occurrences are replaced by a Subshape-Command (7). The runs are found
+	 by sorting the hashes of all runs of a given number of commands, starting with the longest
+	 runs.
+
+	 A run is only extracted, if the position stack is balanced inside of it, so the push limit is
+	 kept. It must not start with a command after a Do-Next-Command (14) and must not end with a
+	 Do-Next-Command. The new shapes get unused numbers, which can be referenced with the one byte
+	 numbers of normal fonts or the two byte numbers of the private use area of Unicode fonts. In
+	 bigfonts the new shapes get unused double byte numbers of the escape ranges, so the font stays
+	 valid. Normal text fonts, i.e. with shape 0, get only the free control codes and DEL, because
+	 all other numbers are characters, which are typed.
+	 */
+	class Deduplicator
+	{
+		public:
+
+			// The numbers of commands of the runs, which are searched, longest first.
+			static const uint32 kRunLengths[];
+
+			Deduplicator(bool unicode);
+
+			/*!
+			 \brief Sets the escape ranges of a bigfont. The new shapes get numbers, whose lead byte
+			 is in one of the ranges. Without ranges no shapes are extracted.
+			 */
+			void setEscapeRanges(const std::vector<EscapeRange> &ranges);
+
+			/*!
+			 \brief Extracts the repeated runs of the shapes into new shapes. The spec bytes must be
+			 valid. Shape 0 of a font is not changed.
+			 \return The number of bytes saved, including the costs of the new shapes.
+			 */
+			uint32 run(ShapeTable &shapes);
+
+			/*!
+			 \brief Returns the number of new shapes of the last run.
+			 */
+			uint32 subshapes() const;
+
+			/*!
+			 \brief Returns true, if the last run left runs, which save bytes, because no shape
+			 number was free for them.
+			 */
+			bool exhausted() const;
+
+		private:
+
+			/*!
+			 \brief A run, which is moved into a new shape.
+			 */
+			struct Extraction
+			{
+				// The number of the new shape.
+				uint16 number;
+
+				// The first command of the first occurrence.
+				uint32 command;
+
+				// The number of commands.
+				uint32 length;
+			};
+
+			// Status whether the font is a Unicode font.
+			bool mUnicode;
+
+			// The spec bytes of all shapes one after another.
+			std::vector<uint8> mBytes;
+
+			// The prefix hashes of mBytes.
+			std::vector<uint64> mHash;
+
+			// The powers of the hash base.
+			std::vector<uint64> mPower;
+
+			// The offset of each command in mBytes.
+			std::vector<uint32> mStart;
+
+			// The index of the final 0 of the shape of each command. Runs must end before it.
+			std::vector<uint32> mLimit;
+
+			// The depth of the position stack before each command.
+			std::vector<int32> mDepth;
+
+			// Status for each command, whether it follows a Do-Next-Command (14).
+			std::vector<uint8> mConditional;
+
+			// The extraction + 1, which starts at the command, or 0.
+			std::vector<uint32> mReplace;
+
+			// Status for each command, whether it is part of an extracted run.
+			std::vector<uint8> mUsed;
+
+			// The first command of each shape.
+			std::vector<uint32> mFirst;
+
+			// The extracted runs.
+			std::vector<Extraction> mExtractions;
+
+			// The shape numbers in use.
+			std::vector<uint8> mNumbers;
+
+			// Status whether the font is a bigfont.
+			bool mBigfont;
+
+			// For each byte, whether it is a lead byte of an escape range of a bigfont.
+			std::vector<uint8> mLeadBytes;
+
+			// The next candidate for the number of a new shape.
+			uint32 mNextNumber;
+
+			// The lowest number of a new shape.
+			uint32 mLowestNumber;
+
+			// The number of bytes saved.
+			int64 mSaved;
+
+			// Status whether runs were left, because no number was free.
+			bool mExhausted;
+
+			void prepare(const ShapeTable &shapes);
+
+			uint64 hash(uint32 command, uint32 length) const;
+
+			uint32 size(uint32 command, uint32 length) const;
+
+			bool isCandidate(uint32 command, uint32 length) const;
+
+			bool equals(uint32 a, uint32 b, uint32 length) const;
+
+			int32 gain(uint32 occurrences, uint32 bytes) const;
+
+			bool nextNumber(uint16 &number);
+
+			void search(uint32 length);
+
+			void rebuild(ShapeTable &shapes) const;
+	};
+
+}
+
+#endif
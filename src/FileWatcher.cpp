@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        FileWatcher.cpp
+// Application: Shape File Compiler
+// Purpose:     Waits for changes of a file
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "FileWatcher.h"
+
+using namespace shpc;
+
+/*!
+ \brief Time in milliseconds, in which further changes are combined with the first one.
+ */
+static const int kSettleTime = 20;
+
+#ifdef __linux__
+
+FileWatcher::FileWatcher(const jm::String &filename)
+{
+	jm::File file(filename);
+	jm::ByteArray directory = file.parent().toCString();
+	jm::ByteArray name = file.name().toCString();
+	mName = name.constData();
+
+	mHandle = inotify_init1(IN_CLOEXEC);
+	if(mHandle < 0)throw jm::Exception("Cannot watch file: " + filename);
+
+	mWatch = inotify_add_watch(mHandle, directory.constData(), IN_CLOSE_WRITE | IN_MOVED_TO);
+	if(mWatch < 0)
+	{
+		close(mHandle);
+		throw jm::Exception("Cannot watch file: " + filename);
+	}
+}
+
+FileWatcher::~FileWatcher()
+{
+	inotify_rm_watch(mHandle, mWatch);
+	close(mHandle);
+}
+
+void FileWatcher::wait()
+{
+	alignas(struct inotify_event) char buffer[4096];
+	bool changed = false;
+
+	while(true)
+	{
+		// After the first change only wait shortly for further events.
+		struct pollfd fd;
+		fd.fd = mHandle;
+		fd.events = POLLIN;
+		fd.revents = 0;
+		int ready = poll(&fd, 1, changed ? kSettleTime : -1);
+		if(ready == 0)return;
+		if(ready < 0)continue;
+
+		ssize_t length = read(mHandle, buffer, sizeof(buffer));
+		if(length <= 0)continue;
+
+		for(char* p = buffer; p < buffer + length;)
+		{
+			const struct inotify_event* event = (const struct inotify_event*)p;
+			if(event->len > 0 && mName == event->name)changed = true;
+			p += sizeof(struct inotify_event) + event->len;
+		}
+	}
+}
+
+#else
+
+FileWatcher::FileWatcher(const jm::String &filename)
+{
+	mHandle = -1;
+	mWatch = -1;
+	throw jm::Exception("Watching files is not supported on this platform: " + filename);
+}
+
+FileWatcher::~FileWatcher()
+{
+}
+
+void FileWatcher::wait()
+{
+}
+
+#endif
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        FileWatcher.h
+// Application: Shape File Compiler
+// Purpose:     Waits for changes of a file
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_FileWatcher_h
+#define shpc_FileWatcher_h
+
+#include <string>
+
+#include "core/Core.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The watcher waits for changes of a file. Editors often save a file by writing a new file
+	 and renaming it, so the directory of the file is watched. Currently only Linux (inotify) is
+	 supported.
+	 */
+	class FileWatcher
+	{
+		public:
+
+			/*!
+			 \brief Constructor. Throws an exception, if the file cannot be watched.
+			 */
+			FileWatcher(const jm::String &filename);
+
+			~FileWatcher();
+
+			/*!
+			 \brief Blocks until the file was written or replaced. Changes in short order, e.g. by
+			 one save of an editor, are combined.
+			 */
+			void wait();
+
+		private:
+
+			// The name of the file without directory.
+			std::string mName;
+
+			// The handle of the inotify instance.
+			int mHandle;
+
+			// The handle of the watch on the directory.
+			int mWatch;
+	};
+
+}
+
+#endif
@@ -0,0 +1,494 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        FontDiff.cpp
+// Application: Shape File Compiler
+// Purpose:     Structural comparison of two fonts
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#include "AtomicFile.h"
+#include "FontDiff.h"
+#include "Interpreter.h"
+
+using namespace shpc;
+
+// The number of shape numbers compared by one task.
+static const uint32 kNumbersPerTask = 4096;
+
+// The index of shape numbers, which do not exist.
+static const uint32 kNotFound = 0xFFFFFFFF;
+
+/*!
+ \brief Returns the name of the file type for the report.
+ */
+static const char* formatName(ShxFormat format)
+{
+	switch(format)
+	{
+		case ShxFormat::kShapes10:
+			return "shapes 1.0";
+		case ShxFormat::kShapes11:
+			return "shapes 1.1";
+		case ShxFormat::kUnifont:
+			return "unifont 1.0";
+		case ShxFormat::kBigfont:
+			return "bigfont 1.0";
+	}
+	return "unknown";
+}
+
+/*!
+ \brief Returns true, if the metrics differ in the bounding box or the advance.
+ */
+static bool differ(const GlyphMetrics &a, const GlyphMetrics &b)
+{
+	return a.minimum.x != b.minimum.x || a.minimum.y != b.minimum.y
+	       || a.maximum.x != b.maximum.x || a.maximum.y != b.maximum.y
+	       || a.advance.x != b.advance.x || a.advance.y != b.advance.y;
+}
+
+/*!
+ \brief Returns true, if the escape ranges are the same.
+ */
+static bool sameRanges(const std::vector<EscapeRange> &a, const std::vector<EscapeRange> &b)
+{
+	if(a.size() != b.size())return false;
+	for(size_t c = 0; c < a.size(); c++)
+	{
+		if(a[c].first != b[c].first || a[c].last != b[c].last)return false;
+	}
+	return true;
+}
+
+FontDiff::FontDiff()
+{
+	mVerbose = false;
+	mPool = nullptr;
+	mGeometry = false;
+	mUnchanged = 0;
+}
+
+void FontDiff::setVerbose(bool verbose)
+{
+	mVerbose = verbose;
+}
+
+void FontDiff::setThreadPool(ThreadPool* pool)
+{
+	mPool = pool;
+}
+
+void FontDiff::setGeometry(bool geometry)
+{
+	mGeometry = geometry;
+}
+
+bool FontDiff::run(const jm::String &oldname, const jm::String &newname)
+{
+	try
+	{
+		process(oldname, newname);
+	}
+	catch(jm::Exception &e)
+	{
+		report(Severity::kError, e.errorMessage());
+		mDifferences.clear();
+		mText.clear();
+		return false;
+	}
+	return true;
+}
+
+const std::vector<ShapeDiff>& FontDiff::differences() const
+{
+	return mDifferences;
+}
+
+uint32 FontDiff::unchanged() const
+{
+	return mUnchanged;
+}
+
+bool FontDiff::equal() const
+{
+	return mOld.format() == mNew.format()
+	       && sameRanges(mOld.escapeRanges(), mNew.escapeRanges())
+	       && mDifferences.empty();
+}
+
+const std::string& FontDiff::text() const
+{
+	return mText;
+}
+
+void FontDiff::save(const jm::String &filename) const
+{
+	saveAtomic(filename, (const uint8*)mText.data(), mText.size());
+}
+
+const std::vector<Diagnostic>& FontDiff::diagnostics() const
+{
+	return mDiagnostics;
+}
+
+void FontDiff::report(Severity severity, const jm::String &message)
+{
+	mDiagnostics.push_back(Diagnostic(severity, 0, message));
+}
+
+/*!
+ \brief This method controls the comparison as a whole.
+ */
+void FontDiff::process(const jm::String &oldname, const jm::String &newname)
+{
+	mDifferences.clear();
+	mUnchanged = 0;
+	mText.clear();
+	mDiagnostics.clear();
+
+	load(mOld, oldname, mOldIndex);
+	load(mNew, newname, mNewIndex);
+
+	std::vector<Section> sections;
+	for(uint32 begin = 0; begin < 0x10000; begin += kNumbersPerTask)
+	{
+		Section section;
+		section.begin = begin;
+		section.end = begin + kNumbersPerTask;
+		section.unchanged = 0;
+		section.failed = false;
+		sections.push_back(section);
+	}
+
+	if(mPool != nullptr)
+	{
+		TaskGroup group;
+		for(size_t a = 0; a < sections.size(); a++)
+		{
+			Section* section = &sections[a];
+			mPool->submit([this, section]
+			{
+				try
+				{
+					compare(*section);
+				}
+				catch(jm::Exception &e)
+				{
+					section->failed = true;
+					section->error = e.errorMessage();
+				}
+			}, &group);
+		}
+		mPool->wait(group);
+	}
+	else
+	{
+		for(size_t a = 0; a < sections.size(); a++)compare(sections[a]);
+	}
+
+	// The sections are joined in order, so the differences are ordered by number.
+	for(size_t a = 0; a < sections.size(); a++)
+	{
+		const Section &section = sections[a];
+		if(section.failed)throw jm::Exception(section.error);
+		mDifferences.insert(mDifferences.end(),
+		                    section.differences.begin(),
+		                    section.differences.end());
+		mUnchanged += section.unchanged;
+	}
+
+	write(oldname, newname);
+
+	if(mVerbose)
+		report(Severity::kInfo, jm::String::valueOf((int64)mOld.shapes().size())
+		       + " and "
+		       + jm::String::valueOf((int64)mNew.shapes().size())
+		       + " Shapes compared, "
+		       + jm::String::valueOf((int64)mDifferences.size())
+		       + " differ.");
+}
+
+/*!
+ \brief Reads the font and builds the index of its shape numbers.
+ */
+void FontDiff::load(FontFile &font, const jm::String &filename, std::vector<uint32> &index)
+{
+	font.setVerbose(mVerbose);
+	font.setThreadPool(mPool);
+	bool success = font.load(filename);
+	const std::vector<Diagnostic> &diagnostics = font.diagnostics();
+	mDiagnostics.insert(mDiagnostics.end(), diagnostics.begin(), diagnostics.end());
+	if(!success)throw jm::Exception("Cannot read \"" + filename + "\".");
+
+	const ShapeTable &shapes = font.shapes();
+	index.assign(0x10000, kNotFound);
+	for(uint32 a = 0; a < shapes.size(); a++)
+	{
+		uint16 number = shapes.number(a);
+		if(index[number] != kNotFound)
+			throw jm::Exception("\"" + filename + "\": Shape number "
+			                    + jm::String::valueOf((int64)number)
+			                    + " is defined twice.");
+		index[number] = a;
+	}
+}
+
+/*!
+ \brief Compares the shapes with the numbers of the section. The names and spec bytes are compared
+ byte by byte. If the geometry is compared, each section interprets the shapes with interpreters
+ of its own.
+ */
+void FontDiff::compare(Section &section) const
+{
+	const ShapeTable &oldShapes = mOld.shapes();
+	const ShapeTable &newShapes = mNew.shapes();
+
+	// The interpreters index all shapes, so they are only created, if the geometry is compared.
+	std::unique_ptr<Interpreter> oldInterpreter;
+	std::unique_ptr<Interpreter> newInterpreter;
+	Outline outline;
+
+	for(uint32 number = section.begin; number < section.end; number++)
+	{
+		uint32 oldIndex = mOldIndex[number];
+		uint32 newIndex = mNewIndex[number];
+		if(oldIndex == kNotFound && newIndex == kNotFound)continue;
+
+		ShapeDiff diff;
+		diff.number = (uint16)number;
+		diff.oldIndex = oldIndex;
+		diff.newIndex = newIndex;
+		diff.name = false;
+		diff.specBytes = false;
+		diff.geometry = false;
+		diff.oldMetrics = GlyphMetrics();
+		diff.newMetrics = GlyphMetrics();
+
+		if(oldIndex == kNotFound)
+		{
+			diff.kind = DiffKind::kAdded;
+			section.differences.push_back(diff);
+			continue;
+		}
+		if(newIndex == kNotFound)
+		{
+			diff.kind = DiffKind::kRemoved;
+			section.differences.push_back(diff);
+			continue;
+		}
+		diff.kind = DiffKind::kChanged;
+
+		uint16 length = oldShapes.nameLength(oldIndex);
+		diff.name = length != newShapes.nameLength(newIndex)
+		            || std::memcmp(oldShapes.encodedName(oldIndex),
+		                           newShapes.encodedName(newIndex),
+		                           length) != 0;
+
+		uint16 defBytes = oldShapes.defBytes(oldIndex);
+		diff.specBytes = defBytes != newShapes.defBytes(newIndex)
+		                 || std::memcmp(oldShapes.buffer(oldIndex),
+		                                newShapes.buffer(newIndex),
+		                                defBytes) != 0;
+
+		// Shape 0 holds the font header and is not drawn.
+		if(mGeometry && number != 0)
+		{
+			if(!oldInterpreter)
+				oldInterpreter.reset(new Interpreter(oldShapes, wideSubshapes(mOld.format())));
+			if(!newInterpreter)
+				newInterpreter.reset(new Interpreter(newShapes, wideSubshapes(mNew.format())));
+
+			try
+			{
+				oldInterpreter->run(oldIndex, outline);
+				diff.oldMetrics.number = diff.number;
+				diff.oldMetrics.minimum = outline.minimum();
+				diff.oldMetrics.maximum = outline.maximum();
+				diff.oldMetrics.advance = outline.advance();
+				diff.oldMetrics.segments = outline.segments();
+
+				newInterpreter->run(newIndex, outline);
+				diff.newMetrics.number = diff.number;
+				diff.newMetrics.minimum = outline.minimum();
+				diff.newMetrics.maximum = outline.maximum();
+				diff.newMetrics.advance = outline.advance();
+				diff.newMetrics.segments = outline.segments();
+			}
+			catch(jm::Exception &e)
+			{
+				throw jm::Exception("Shape " + jm::String::valueOf((int64)number) + ": "
+				                    + e.errorMessage());
+			}
+			diff.geometry = differ(diff.oldMetrics, diff.newMetrics);
+		}
+
+		if(diff.name || diff.specBytes || diff.geometry)section.differences.push_back(diff);
+		else section.unchanged++;
+	}
+}
+
+/*!
+ \brief Writes the number of a shape: hexadecimal in unifonts and for the double byte numbers of
+ bigfonts, decimal otherwise.
+ */
+void FontDiff::writeNumber(uint16 number, std::string &out) const
+{
+	ShxFormat format = mNew.format();
+	char text[16];
+	if(format == ShxFormat::kUnifont)std::snprintf(text, sizeof(text), "U+%04X", number);
+	else if(format == ShxFormat::kBigfont && number > 0xFF)
+		std::snprintf(text, sizeof(text), "0x%04X", number);
+	else std::snprintf(text, sizeof(text), "%u", number);
+	out.append(text);
+}
+
+/*!
+ \brief Writes the name of a shape in quotes. The bytes of the name are taken as they are.
+ */
+void FontDiff::writeName(const FontFile &font, uint32 index, std::string &out) const
+{
+	const ShapeTable &shapes = font.shapes();
+	out.push_back('"');
+	out.append((const char*)shapes.encodedName(index), shapes.nameLength(index));
+	out.push_back('"');
+}
+
+/*!
+ \brief Writes the report: a header with both files, one line per difference and a summary.
+ */
+void FontDiff::write(const jm::String &oldname, const jm::String &newname)
+{
+	const ShapeTable &oldShapes = mOld.shapes();
+	const ShapeTable &newShapes = mNew.shapes();
+
+	jm::ByteArray cname = oldname.toCString();
+	char text[160];
+	std::snprintf(text, sizeof(text), " (%s, %u shapes)\n",
+	              formatName(mOld.format()),
+	              oldShapes.size());
+	mText.append("--- ");
+	mText.append(cname.constData(), (size_t)cname.size());
+	mText.append(text);
+
+	cname = newname.toCString();
+	std::snprintf(text, sizeof(text), " (%s, %u shapes)\n",
+	              formatName(mNew.format()),
+	              newShapes.size());
+	mText.append("+++ ");
+	mText.append(cname.constData(), (size_t)cname.size());
+	mText.append(text);
+
+	uint32 added = 0;
+	uint32 removed = 0;
+	uint32 changed = 0;
+
+	for(size_t a = 0; a < mDifferences.size(); a++)
+	{
+		const ShapeDiff &diff = mDifferences[a];
+		switch(diff.kind)
+		{
+			case DiffKind::kAdded:
+				added++;
+				mText.append("+ ");
+				writeNumber(diff.number, mText);
+				mText.push_back(' ');
+				writeName(mNew, diff.newIndex, mText);
+				std::snprintf(text, sizeof(text), ": %u spec bytes\n",
+				              newShapes.defBytes(diff.newIndex));
+				mText.append(text);
+				break;
+
+			case DiffKind::kRemoved:
+				removed++;
+				mText.append("- ");
+				writeNumber(diff.number, mText);
+				mText.push_back(' ');
+				writeName(mOld, diff.oldIndex, mText);
+				mText.push_back('\n');
+				break;
+
+			case DiffKind::kChanged:
+			{
+				changed++;
+				mText.append("~ ");
+				writeNumber(diff.number, mText);
+				mText.push_back(' ');
+				writeName(mNew, diff.newIndex, mText);
+				mText.push_back(':');
+
+				const char* separator = " ";
+				if(diff.name)
+				{
+					mText.append(separator);
+					mText.append("name ");
+					writeName(mOld, diff.oldIndex, mText);
+					mText.append(" -> ");
+					writeName(mNew, diff.newIndex, mText);
+					separator = "; ";
+				}
+				if(diff.specBytes)
+				{
+					uint16 oldBytes = oldShapes.defBytes(diff.oldIndex);
+					uint16 newBytes = newShapes.defBytes(diff.newIndex);
+					if(oldBytes == newBytes)
+						std::snprintf(text, sizeof(text), "%sspec bytes changed", separator);
+					else
+						std::snprintf(text, sizeof(text), "%sspec bytes %u -> %u",
+						              separator,
+						              oldBytes,
+						              newBytes);
+					mText.append(text);
+					separator = "; ";
+				}
+				if(diff.geometry)
+				{
+					const GlyphMetrics &o = diff.oldMetrics;
+					const GlyphMetrics &n = diff.newMetrics;
+					std::snprintf(text, sizeof(text),
+					              "%sbbox (%g,%g)-(%g,%g) -> (%g,%g)-(%g,%g)",
+					              separator,
+					              o.minimum.x, o.minimum.y, o.maximum.x, o.maximum.y,
+					              n.minimum.x, n.minimum.y, n.maximum.x, n.maximum.y);
+					mText.append(text);
+					std::snprintf(text, sizeof(text), "; advance (%g,%g) -> (%g,%g)",
+					              o.advance.x, o.advance.y, n.advance.x, n.advance.y);
+					mText.append(text);
+				}
+				mText.push_back('\n');
+				break;
+			}
+		}
+	}
+
+	if(!sameRanges(mOld.escapeRanges(), mNew.escapeRanges()))mText.append("Escape ranges differ.\n");
+
+	std::snprintf(text, sizeof(text), "%u added, %u removed, %u changed, %u unchanged.\n",
+	              added, removed, changed, mUnchanged);
+	mText.append(text);
+}
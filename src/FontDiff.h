@@ -0,0 +1,238 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        FontDiff.h
+// Application: Shape File Compiler
+// Purpose:     Structural comparison of two fonts
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef shpc_FontDiff_h
+#define shpc_FontDiff_h
+
+#include <string>
+#include <vector>
+
+#include "core/Core.h"
+
+#include "Compiler.h"
+#include "FontFile.h"
+#include "MetricsFile.h"
+#include "ThreadPool.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The kind of a difference of a shape between two fonts.
+	 */
+	enum class DiffKind
+	{
+		// The shape exists only in the new font.
+		kAdded,
+
+		// The shape exists only in the old font.
+		kRemoved,
+
+		// The shape exists in both fonts, but differs.
+		kChanged
+	};
+
+	/*!
+	 \brief A shape, which differs between two fonts.
+	 */
+	struct ShapeDiff
+	{
+		// The shape number.
+		uint16 number;
+
+		// The kind of the difference.
+		DiffKind kind;
+
+		// The index of the shape in the old font and in the new font, if it exists there.
+		uint32 oldIndex;
+		uint32 newIndex;
+
+		// Status whether the names differ.
+		bool name;
+
+		// Status whether the spec bytes differ.
+		bool specBytes;
+
+		// Status whether the bounding box or the advance differ. Only determined, if the geometry
+		// is compared.
+		bool geometry;
+
+		// The metrics of the shape in the old font and in the new font, if the geometry is
+		// compared.
+		GlyphMetrics oldMetrics;
+		GlyphMetrics newMetrics;
+	};
+
+	/*!
+	 \brief The diff compares two fonts shape by shape, e.g. an old and a new release of a font. Both
+	 fonts are indexed by shape number in a table with one entry per possible number, so each shape
+	 is found in constant time. Then the names and spec bytes of the shapes are compared in sections
+	 of numbers on the thread pool.
+
+	 Optionally the shapes of both fonts are interpreted and their bounding boxes and advances are
+	 compared as well. This also finds shapes, which changed only because one of their subshapes
+	 changed.
+	 */
+	class FontDiff
+	{
+		public:
+
+			FontDiff();
+
+			/*!
+			 \brief Status whether detailed information is added to the diagnostics.
+			 */
+			void setVerbose(bool verbose);
+
+			/*!
+			 \brief Sets the thread pool, on which the fonts are compared. If nullptr (default),
+			 they are compared in the calling thread.
+			 */
+			void setThreadPool(ThreadPool* pool);
+
+			/*!
+			 \brief Status whether the bounding boxes and advances of the shapes are compared.
+			 Default: false.
+			 */
+			void setGeometry(bool geometry);
+
+			/*!
+			 \brief Reads both fonts and compares them. Each font may be a SHX or a SHP file.
+			 \return true on success. On failure the diagnostics contain at least one error.
+			 */
+			bool run(const jm::String &oldname, const jm::String &newname);
+
+			/*!
+			 \brief Returns the differences ordered by shape number.
+			 */
+			const std::vector<ShapeDiff>& differences() const;
+
+			/*!
+			 \brief Returns the number of shapes, which exist in both fonts and are equal.
+			 */
+			uint32 unchanged() const;
+
+			/*!
+			 \brief Returns true, if both fonts have the same file type, the same escape ranges and
+			 no differences.
+			 */
+			bool equal() const;
+
+			/*!
+			 \brief Returns the report of the differences: one line per shape, which starts with
+			 "+" for added, "-" for removed and "~" for changed shapes, and a summary.
+			 */
+			const std::string& text() const;
+
+			/*!
+			 \brief Saves the report.
+			 \throws jm::Exception, if the file cannot be written.
+			 */
+			void save(const jm::String &filename) const;
+
+			/*!
+			 \brief Returns all messages. Messages of the compilation of a SHP file start with the
+			 name of the file.
+			 */
+			const std::vector<Diagnostic>& diagnostics() const;
+
+		private:
+
+			/*!
+			 \brief The differences found by one task.
+			 */
+			struct Section
+			{
+				// The first shape number of the section.
+				uint32 begin;
+
+				// The shape number after the section.
+				uint32 end;
+
+				// The differences.
+				std::vector<ShapeDiff> differences;
+
+				// The number of equal shapes.
+				uint32 unchanged;
+
+				// Status whether the comparison failed.
+				bool failed;
+
+				// The error message, if the comparison failed.
+				jm::String error;
+			};
+
+			// Status whether detailed information is reported.
+			bool mVerbose;
+
+			// The pool for the comparison or nullptr.
+			ThreadPool* mPool;
+
+			// Status whether the geometry is compared.
+			bool mGeometry;
+
+			// The old and the new font.
+			FontFile mOld;
+			FontFile mNew;
+
+			// The index of the shape of each shape number in the old and in the new font.
+			std::vector<uint32> mOldIndex;
+			std::vector<uint32> mNewIndex;
+
+			// The differences.
+			std::vector<ShapeDiff> mDifferences;
+
+			// The number of equal shapes.
+			uint32 mUnchanged;
+
+			// The report.
+			std::string mText;
+
+			// The messages.
+			std::vector<Diagnostic> mDiagnostics;
+
+			void process(const jm::String &oldname, const jm::String &newname);
+
+			void load(FontFile &font, const jm::String &filename, std::vector<uint32> &index);
+
+			void compare(Section &section) const;
+
+			void write(const jm::String &oldname, const jm::String &newname);
+
+			void writeNumber(uint16 number, std::string &out) const;
+
+			void writeName(const FontFile &font, uint32 index, std::string &out) const;
+
+			void report(Severity severity, const jm::String &message);
+	};
+
+}
+
+#endif
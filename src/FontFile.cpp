@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        FontFile.cpp
+// Application: Shape File Compiler
+// Purpose:     Fonts read from SHX or SHP files
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+
+#include "FontFile.h"
+#include "ShxFont.h"
+#include "SpecValidator.h"
+
+using namespace shpc;
+
+FontFile::FontFile()
+{
+	mVerbose = false;
+	mPool = nullptr;
+	mResolveReferences = true;
+	mFormat = ShxFormat::kShapes10;
+}
+
+void FontFile::setVerbose(bool verbose)
+{
+	mVerbose = verbose;
+}
+
+void FontFile::setThreadPool(ThreadPool* pool)
+{
+	mPool = pool;
+}
+
+void FontFile::setResolveReferences(bool resolve)
+{
+	mResolveReferences = resolve;
+}
+
+bool FontFile::load(const jm::String &filename)
+{
+	mShapes.clear();
+	mEscapes.clear();
+	mDiagnostics.clear();
+
+	try
+	{
+		if(filename.toLowerCase().endsWith(".shx"))read(filename);
+		else compile(filename);
+	}
+	catch(jm::Exception &e)
+	{
+		report(Severity::kError, filename + ": " + e.errorMessage());
+		mShapes.clear();
+		return false;
+	}
+	return true;
+}
+
+const ShapeTable& FontFile::shapes() const
+{
+	return mShapes;
+}
+
+ShxFormat FontFile::format() const
+{
+	return mFormat;
+}
+
+const std::vector<EscapeRange>& FontFile::escapeRanges() const
+{
+	return mEscapes;
+}
+
+const std::vector<Diagnostic>& FontFile::diagnostics() const
+{
+	return mDiagnostics;
+}
+
+void FontFile::report(Severity severity, const jm::String &message)
+{
+	mDiagnostics.push_back(Diagnostic(severity, 0, message));
+}
+
+/*!
+ \brief Reads the shapes of a SHX file ordered by number.
+ */
+void FontFile::read(const jm::String &filename)
+{
+	ShxFont font;
+	font.load(filename);
+	mFormat = font.format();
+	mEscapes = font.escapeRanges();
+
+	std::vector<ShxShape> shapes(font.size());
+	uint32 arena = 0;
+	for(uint32 a = 0; a < font.size(); a++)
+	{
+		shapes[a] = font.shape(a);
+		arena += shapes[a].nameLength + 1 + shapes[a].defBytes;
+	}
+
+	// Other tools may write the shapes in any order.
+	std::stable_sort(shapes.begin(), shapes.end(), [](const ShxShape &a, const ShxShape &b)
+	{
+		return a.number < b.number;
+	});
+
+	mShapes.reserve(arena);
+	for(size_t a = 0; a < shapes.size(); a++)
+	{
+		const ShxShape &shape = shapes[a];
+		uint32 index = mShapes.add(shape.number, shape.defBytes, shape.name, shape.nameLength);
+		for(uint16 b = 0; b < shape.defBytes; b++)mShapes.append(index, shape.specBytes[b]);
+	}
+
+	validate(filename);
+}
+
+/*!
+ \brief Checks the spec bytes of the shapes, which were read from a SHX file. The tools, which work
+ on the shapes, expect complete commands and would read beyond the end of a broken shape.
+ */
+void FontFile::validate(const jm::String &filename)
+{
+	bool wide = wideSubshapes(mFormat);
+	bool unicode = mFormat == ShxFormat::kUnifont;
+	uint32 failures = 0;
+
+	for(uint32 a = 0; a < mShapes.size(); a++)
+	{
+		const uint8* bytes = mShapes.buffer(a);
+		uint32 defBytes = mShapes.defBytes(a);
+
+		jm::String message;
+		if(mShapes.number(a) != 0 && defBytes == 0)message = "Shape has no spec bytes.";
+		else
+		{
+			SpecResult result;
+			if(mShapes.number(a) == 0)result = validateFontInfo(bytes, defBytes, unicode);
+			else if(wide)result = validateSpec<true>(bytes, defBytes);
+			else result = validateSpec<false>(bytes, defBytes);
+			if(result.error == SpecError::kNone)continue;
+			message = specErrorMessage(result, wide);
+		}
+
+		report(Severity::kError, filename + ": Shape "
+		       + jm::String::valueOf((int64)mShapes.number(a))
+		       + ": " + message);
+		failures++;
+	}
+
+	if(failures > 0)throw jm::Exception("Invalid shapes found.");
+}
+
+/*!
+ \brief Compiles a SHP file. Its messages are added to the diagnostics.
+ */
+void FontFile::compile(const jm::String &filename)
+{
+	jm::File file(filename);
+	if(!file.exists())throw jm::Exception("File does not exist.");
+
+	Compiler compiler;
+	compiler.setVerbose(mVerbose);
+	compiler.setThreadPool(mPool);
+	compiler.setResolveReferences(mResolveReferences);
+
+	file.open(jm::FileMode::kRead);
+	bool success = compiler.compile(&file);
+	file.close();
+
+	const std::vector<Diagnostic> &diagnostics = compiler.diagnostics();
+	for(size_t a = 0; a < diagnostics.size(); a++)
+	{
+		Diagnostic diagnostic = diagnostics[a];
+		diagnostic.message = filename + ": " + diagnostic.message;
+		mDiagnostics.push_back(diagnostic);
+	}
+	if(!success)throw jm::Exception("Cannot compile.");
+
+	// The compiler checked, that the shapes are ordered by number.
+	mShapes = compiler.shapes();
+	mFormat = compiler.format();
+	mEscapes = compiler.escapeRanges();
+}
@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        FontFile.h
+// Application: Shape File Compiler
+// Purpose:     Fonts read from SHX or SHP files
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef shpc_FontFile_h
+#define shpc_FontFile_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+#include "Compiler.h"
+#include "ShapeTable.h"
+#include "ShxImage.h"
+#include "ThreadPool.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief A font, which is read from a SHX file or compiled from a SHP file, for tools, which work
+	 on the shapes of existing fonts. SHX files are not compiled again, their records are copied
+	 into the shape table as they are.
+	 */
+	class FontFile
+	{
+		public:
+
+			FontFile();
+
+			/*!
+			 \brief Status whether detailed information is added to the diagnostics.
+			 */
+			void setVerbose(bool verbose);
+
+			/*!
+			 \brief Sets the thread pool, on which large SHP files are compiled. If nullptr
+			 (default), the file is compiled in the calling thread.
+			 */
+			void setThreadPool(ThreadPool* pool);
+
+			/*!
+			 \brief Status whether the subshape references of SHP files are resolved. If false,
+			 references to shapes of other fonts are allowed, e.g. if the font is merged with others.
+			 Default: true.
+			 */
+			void setResolveReferences(bool resolve);
+
+			/*!
+			 \brief Reads the font. Files with the extension ".shx" are read as SHX files, all
+			 others are compiled as SHP files.
+			 \return true on success. On failure the diagnostics contain at least one error.
+			 */
+			bool load(const jm::String &filename);
+
+			/*!
+			 \brief Returns the shapes ordered by number.
+			 */
+			const ShapeTable& shapes() const;
+
+			/*!
+			 \brief Returns the file type.
+			 */
+			ShxFormat format() const;
+
+			/*!
+			 \brief Returns the escape ranges of a bigfont.
+			 */
+			const std::vector<EscapeRange>& escapeRanges() const;
+
+			/*!
+			 \brief Returns the messages of the last loading. Each one starts with the name of the
+			 file.
+			 */
+			const std::vector<Diagnostic>& diagnostics() const;
+
+		private:
+
+			// Status whether detailed information is reported.
+			bool mVerbose;
+
+			// The pool for the compilation or nullptr.
+			ThreadPool* mPool;
+
+			// Status whether the subshape references of SHP files are resolved.
+			bool mResolveReferences;
+
+			// The shapes ordered by number.
+			ShapeTable mShapes;
+
+			// The file type.
+			ShxFormat mFormat;
+
+			// The escape ranges of a bigfont.
+			std::vector<EscapeRange> mEscapes;
+
+			// The messages of the compilation.
+			std::vector<Diagnostic> mDiagnostics;
+
+			void report(Severity severity, const jm::String &message);
+
+			void read(const jm::String &filename);
+
+			void validate(const jm::String &filename);
+
+			void compile(const jm::String &filename);
+	};
+
+}
+
+#endif
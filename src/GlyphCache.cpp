@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        GlyphCache.cpp
+// Application: Shape File Compiler
+// Purpose:     Cache of the outlines of the shapes
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GlyphCache.h"
+
+using namespace shpc;
+
+GlyphCache::GlyphCache(const ShapeTable &shapes, bool unicode):
+	mShapes(shapes), mInterpreter(shapes, unicode)
+{
+	mOutlines.resize(shapes.size());
+	mReady.assign(shapes.size(), 0);
+	mSize = 0;
+
+	// The first byte of the font information is the height above the baseline.
+	mAbove = 1;
+	uint32 info = mInterpreter.find(0);
+	if(info < shapes.size() && shapes.defBytes(info) > 0 && shapes.buffer(info)[0] > 0)
+		mAbove = shapes.buffer(info)[0];
+}
+
+void GlyphCache::prepare()
+{
+	for(uint32 a = 0; a < mShapes.size(); a++)
+	{
+		if(mReady[a] != 0)continue;
+
+		mInterpreter.run(a, mOutlines[a]);
+		mReady[a] = 1;
+		mSize++;
+	}
+}
+
+const Outline* GlyphCache::find(uint16 number)
+{
+	uint32 index = mInterpreter.find(number);
+	if(index >= mShapes.size())return nullptr;
+
+	if(mReady[index] == 0)
+	{
+		mInterpreter.run(index, mOutlines[index]);
+		mReady[index] = 1;
+		mSize++;
+	}
+	return &mOutlines[index];
+}
+
+float GlyphCache::above() const
+{
+	return mAbove;
+}
+
+uint32 GlyphCache::size() const
+{
+	return mSize;
+}
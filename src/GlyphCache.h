@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        GlyphCache.h
+// Application: Shape File Compiler
+// Purpose:     Cache of the outlines of the shapes
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_GlyphCache_h
+#define shpc_GlyphCache_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+#include "Interpreter.h"
+#include "Outline.h"
+#include "ShapeTable.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The cache holds the flattened outlines of the shapes of a font. Each shape is interpreted
+	 on first use, so that repeated text does not interpret its shapes again. The cache must not be
+	 used by several threads at once, unless all shapes were prepared before.
+	 */
+	class GlyphCache
+	{
+		public:
+
+			/*!
+			 \brief Constructor. The shape table must exist during the lifetime of the cache and its
+			 spec bytes must be valid.
+			 */
+			GlyphCache(const ShapeTable &shapes, bool unicode);
+
+			/*!
+			 \brief Interprets all shapes, which are not in the cache yet. Afterwards the cache may
+			 be read by several threads at once.
+			 \throws jm::Exception, if a subshape does not exist.
+			 */
+			void prepare();
+
+			/*!
+			 \brief Returns the outline of the shape with the number or nullptr, if the font has no
+			 such shape. Shape 0 is font information and has an empty outline.
+			 \throws jm::Exception, if a subshape does not exist.
+			 */
+			const Outline* find(uint16 number);
+
+			/*!
+			 \brief Returns the height of the capital letters above the baseline from the font
+			 information or 1, if the font has no such information.
+			 */
+			float above() const;
+
+			/*!
+			 \brief Returns the number of shapes in the cache.
+			 */
+			uint32 size() const;
+
+		private:
+
+			// The shapes.
+			const ShapeTable &mShapes;
+
+			// The interpreter for the shapes.
+			Interpreter mInterpreter;
+
+			// The outline of each shape.
+			std::vector<Outline> mOutlines;
+
+			// Status for each shape, whether its outline is in the cache.
+			std::vector<uint8> mReady;
+
+			// The number of shapes in the cache.
+			uint32 mSize;
+
+			// The height above the baseline.
+			float mAbove;
+	};
+
+}
+
+#endif
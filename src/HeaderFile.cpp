@@ -0,0 +1,250 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        HeaderFile.cpp
+// Application: Shape File Compiler
+// Purpose:     C++ header with a compiled font
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "AtomicFile.h"
+#include "HeaderFile.h"
+#include "ShxFont.h"
+
+using namespace shpc;
+
+// The number of bytes in one line of the array.
+static const uint32 kBytesPerLine = 16;
+
+static const char kHex[] = "0123456789abcdef";
+
+// The keywords of C++ up to C++20 and the alternative tokens, which cannot be namespaces. The
+// namespace std is reserved.
+static const char* const kKeywords[] =
+{
+	"alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break",
+	"case", "catch", "char", "char8_t", "char16_t", "char32_t", "class", "compl", "concept",
+	"const", "consteval", "constexpr", "constinit", "const_cast", "continue", "co_await",
+	"co_return", "co_yield", "decltype", "default", "delete", "do", "double", "dynamic_cast",
+	"else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if",
+	"inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr",
+	"operator", "or", "or_eq", "private", "protected", "public", "register", "reinterpret_cast",
+	"requires", "return", "short", "signed", "sizeof", "static", "static_assert", "static_cast",
+	"std", "struct", "switch", "template", "this", "thread_local", "throw", "true", "try",
+	"typedef", "typeid", "typename", "union", "unsigned", "using", "virtual", "void", "volatile",
+	"wchar_t", "while", "xor", "xor_eq"
+};
+
+// The declarations in the header before the arrays of the font.
+static const char kDeclarations[] =
+	"\t// A shape of the font.\n"
+	"\tstruct Glyph\n"
+	"\t{\n"
+	"\t\t// The shape number.\n"
+	"\t\tstd::uint16_t number;\n"
+	"\n"
+	"\t\t// The number of bytes of the name without terminating zero.\n"
+	"\t\tstd::uint16_t nameLength;\n"
+	"\n"
+	"\t\t// The number of spec bytes.\n"
+	"\t\tstd::uint16_t defBytes;\n"
+	"\n"
+	"\t\t// The position of the record in kShx: the name, a zero and the spec bytes.\n"
+	"\t\tstd::uint32_t offset;\n"
+	"\t};\n"
+	"\n";
+
+// The beginning of the template, which holds the arrays of the font.
+static const char kDataBegin[] =
+	"\t// The arrays of the font. Use kShx and kGlyphs.\n"
+	"\ttemplate<typename T = void>\n"
+	"\tstruct FontData\n"
+	"\t{\n";
+
+// The functions in the header after the table of the shapes.
+static const char kFunctions[] =
+	"\t// Returns the index of the shape with the number in kGlyphs or kGlyphCount, if the font\n"
+	"\t// has no such shape.\n"
+	"\tconstexpr std::size_t find(std::uint16_t number,\n"
+	"\t                           std::size_t low = 0,\n"
+	"\t                           std::size_t high = kGlyphCount)\n"
+	"\t{\n"
+	"\t\treturn low >= high ? kGlyphCount\n"
+	"\t\t       : kGlyphs[low + (high - low) / 2].number < number\n"
+	"\t\t       ? find(number, low + (high - low) / 2 + 1, high)\n"
+	"\t\t       : number < kGlyphs[low + (high - low) / 2].number\n"
+	"\t\t       ? find(number, low, low + (high - low) / 2)\n"
+	"\t\t       : low + (high - low) / 2;\n"
+	"\t}\n"
+	"\n"
+	"\t// Returns the name of the shape at the index, encoded in Windows-1252.\n"
+	"\tconstexpr const std::uint8_t* name(std::size_t index)\n"
+	"\t{\n"
+	"\t\treturn kShx + kGlyphs[index].offset;\n"
+	"\t}\n"
+	"\n"
+	"\t// Returns the spec bytes of the shape at the index.\n"
+	"\tconstexpr const std::uint8_t* specBytes(std::size_t index)\n"
+	"\t{\n"
+	"\t\treturn kShx + kGlyphs[index].offset + kGlyphs[index].nameLength + 1;\n"
+	"\t}\n"
+	"\n";
+
+HeaderFile::HeaderFile()
+{
+}
+
+void HeaderFile::build(const uint8* shx, size_t length, const jm::String &name)
+{
+	ShxFont font;
+	font.load(shx, length);
+
+	// The shapes ordered by number
+	std::vector<uint32> order(font.size());
+	for(uint32 a = 0; a < font.size(); a++)order[a] = a;
+	std::stable_sort(order.begin(), order.end(), [&font](uint32 a, uint32 b)
+	{
+		return font.shape(a).number < font.shape(b).number;
+	});
+
+	jm::ByteArray cname = name.toCString();
+	std::string identifier(cname.constData(), (size_t)cname.size());
+
+	// Each byte takes up to 6 characters, each shape about 32.
+	mText.clear();
+	mText.reserve(length * 6 + order.size() * 32 + sizeof(kDeclarations) + sizeof(kDataBegin)
+	              + sizeof(kFunctions) + 1024);
+
+	mText.append("// Generated by shpc. Do not edit.\n\n");
+	mText.append("#ifndef shpc_font_" + identifier + "_h\n");
+	mText.append("#define shpc_font_" + identifier + "_h\n\n");
+	mText.append("#include <cstddef>\n#include <cstdint>\n\n");
+	mText.append("namespace " + identifier + "\n{\n\n");
+
+	mText.append("\t// Status whether the font is a Unicode font.\n");
+	mText.append(font.isUnicode() ? "\tconstexpr bool kUnicode = true;\n\n"
+	             : "\tconstexpr bool kUnicode = false;\n\n");
+
+	mText.append(kDeclarations);
+
+	std::string size = std::to_string(length);
+	mText.append("\t// The number of shapes.\n");
+	mText.append("\tconstexpr std::size_t kGlyphCount = " + std::to_string(order.size()) + ";\n\n");
+
+	// Arrays at namespace scope would be copied into each translation unit, which includes the
+	// header. The static members of a template are defined only once in the program, the
+	// namespace gets only static references to them.
+	mText.append(kDataBegin);
+
+	mText.append("\t\t// The SHX file.\n");
+	mText.append("\t\tstatic constexpr std::uint8_t kShx[" + size + "] =\n\t\t{");
+	for(size_t a = 0; a < length; a++)
+	{
+		mText.append(a % kBytesPerLine == 0 ? "\n\t\t\t" : " ");
+		mText.append("0x");
+		mText.push_back(kHex[shx[a] >> 4]);
+		mText.push_back(kHex[shx[a] & 0x0F]);
+		if(a + 1 < length)mText.push_back(',');
+	}
+	mText.append("\n\t\t};\n\n");
+
+	mText.append("\t\t// The shapes ordered by number.\n");
+	mText.append("\t\tstatic constexpr Glyph kGlyphs[kGlyphCount] =\n\t\t{\n");
+	char line[64];
+	for(size_t a = 0; a < order.size(); a++)
+	{
+		ShxShape shape = font.shape(order[a]);
+		std::snprintf(line, sizeof(line), "\t\t\t{0x%04x, %u, %u, %u}%s\n",
+		              shape.number,
+		              shape.nameLength,
+		              shape.defBytes,
+		              (uint32)(shape.name - shx),
+		              a + 1 < order.size() ? "," : "");
+		mText.append(line);
+	}
+	mText.append("\t\t};\n\t};\n\n");
+
+	mText.append("\ttemplate<typename T>\n");
+	mText.append("\tconstexpr std::uint8_t FontData<T>::kShx[" + size + "];\n\n");
+	mText.append("\ttemplate<typename T>\n");
+	mText.append("\tconstexpr Glyph FontData<T>::kGlyphs[kGlyphCount];\n\n");
+
+	mText.append("\t// The SHX file.\n");
+	mText.append("\tstatic constexpr const std::uint8_t (&kShx)[" + size + "] =\n");
+	mText.append("\t\tFontData<>::kShx;\n\n");
+	mText.append("\t// The shapes ordered by number.\n");
+	mText.append("\tstatic constexpr const Glyph (&kGlyphs)[kGlyphCount] =\n");
+	mText.append("\t\tFontData<>::kGlyphs;\n\n");
+
+	mText.append(kFunctions);
+
+	mText.append("}\n\n#endif\n");
+}
+
+void HeaderFile::save(const jm::String &filename) const
+{
+	saveAtomic(filename, (const uint8*)mText.data(), mText.size());
+}
+
+const std::string& HeaderFile::text() const
+{
+	return mText;
+}
+
+jm::String HeaderFile::identifier(const jm::String &filename)
+{
+	jm::String name = jm::File(filename).name();
+
+	// Without extension
+	for(uint32 a = name.size(); a > 0; a--)
+	{
+		if(name.charAt(a - 1).unicode() == '.')
+		{
+			name = name.substring(0, a - 1);
+			break;
+		}
+	}
+
+	jm::String identifier;
+	for(uint32 a = 0; a < name.size(); a++)
+	{
+		uint16 c = name.charAt(a).unicode();
+		bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+		identifier.append(jm::Char(valid ? c : '_'));
+	}
+
+	// Identifiers must not start with a digit and must not be keywords.
+	bool prefix = identifier.size() == 0 || (identifier.charAt(0).unicode() >= '0'
+	              && identifier.charAt(0).unicode() <= '9');
+	for(size_t a = 0; !prefix && a < sizeof(kKeywords) / sizeof(kKeywords[0]); a++)
+		prefix = identifier.equals(kKeywords[a]);
+	if(prefix)identifier = "font_" + identifier;
+
+	return identifier;
+}
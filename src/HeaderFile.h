@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        HeaderFile.h
+// Application: Shape File Compiler
+// Purpose:     C++ header with a compiled font
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_HeaderFile_h
+#define shpc_HeaderFile_h
+
+#include <string>
+
+#include "core/Core.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The header file embeds a compiled font into a C++ program, so that no file has to be
+	 read at runtime. It contains in its own namespace:
+
+	 - kShx: the SHX file as constexpr byte array, e.g. for ShxFont::load().
+	 - kGlyphs: for each shape its number, the length of its name, the number of its spec bytes
+	   and the position of its record in kShx, ordered by the shape number.
+	 - find(number): the index in kGlyphs or kGlyphCount, by binary search. It can be evaluated at
+	   compile time.
+	 - specBytes(index) and name(index): pointers into kShx.
+
+	 The arrays are static members of a class template, so they are defined once in the program,
+	 even if the header is included in several translation units. The header needs only C++11.
+	 */
+	class HeaderFile
+	{
+		public:
+
+			HeaderFile();
+
+			/*!
+			 \brief Creates the header for the SHX file.
+			 \param shx The content of the SHX file.
+			 \param length The number of bytes of the SHX file.
+			 \param name The namespace of the font in the header. It must be a valid identifier.
+			 \throws jm::Exception, if the SHX file is corrupt.
+			 */
+			void build(const uint8* shx, size_t length, const jm::String &name);
+
+			/*!
+			 \brief Saves the header.
+			 */
+			void save(const jm::String &filename) const;
+
+			/*!
+			 \brief Returns the text of the header.
+			 */
+			const std::string& text() const;
+
+			/*!
+			 \brief Returns a namespace for the font from the name of the header file, i.e. the file
+			 name without directory and extension, in which all other characters than letters,
+			 digits and underscores are replaced by underscores. Names, which start with a digit or
+			 are C++ keywords, get the prefix "font_".
+			 */
+			static jm::String identifier(const jm::String &filename);
+
+		private:
+
+			// The text of the header.
+			std::string mText;
+	};
+
+}
+
+#endif
@@ -0,0 +1,353 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Interpreter.cpp
+// Application: Shape File Compiler
+// Purpose:     Interpreter for spec bytes
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include "Interpreter.h"
+#include "SpecValidator.h"
+
+using namespace shpc;
+
+static const double kPi = 3.14159265358979323846;
+
+// A quarter circle in steps, i.e. the offset of the cosine in the table of sines.
+static const int32 kQuarter = Interpreter::kFullCircle / 4;
+
+// Marks a shape number without shape in the index.
+static const uint32 kNoShape = 0xFFFFFFFF;
+
+/*!
+ \brief The sines of the angles of a full circle in steps of 1/256 octant, followed by a quarter
+ circle, so that the cosine of an angle is the sine at the angle plus a quarter circle.
+ */
+struct SineTable
+{
+	double values[Interpreter::kFullCircle + kQuarter];
+
+	SineTable()
+	{
+		for(int32 a = 0; a < Interpreter::kFullCircle + kQuarter; a++)
+			values[a] = std::sin(a * 2 * kPi / Interpreter::kFullCircle);
+	}
+};
+
+static const SineTable kSine;
+
+/*!
+ \brief The vectors of length 1 of the 16 directions. The vectors of the odd directions end on the
+ square around the start, e.g. direction 1 at (1, 0.5).
+ */
+static const double kDirections[16][2] =
+{
+	{1, 0}, {1, 0.5}, {1, 1}, {0.5, 1}, {0, 1}, {-0.5, 1}, {-1, 1}, {-1, 0.5},
+	{-1, 0}, {-1, -0.5}, {-1, -1}, {-0.5, -1}, {0, -1}, {0.5, -1}, {1, -1}, {1, -0.5}
+};
+
+/*!
+ \brief Returns the angle in the range of a full circle.
+ */
+static inline int32 wrap(int32 angle)
+{
+	angle %= Interpreter::kFullCircle;
+	return angle < 0 ? angle + Interpreter::kFullCircle : angle;
+}
+
+static inline double sine(int32 angle)
+{
+	return kSine.values[wrap(angle)];
+}
+
+static inline double cosine(int32 angle)
+{
+	return kSine.values[wrap(angle) + kQuarter];
+}
+
+const int32 Interpreter::kFullCircle;
+const int32 Interpreter::kArcStep;
+const uint32 Interpreter::kMaxDepth;
+
+Interpreter::Interpreter(const ShapeTable &shapes, bool unicode): mShapes(shapes)
+{
+	mUnicode = unicode;
+	mVertical = false;
+	mOutline = nullptr;
+	mX = 0;
+	mY = 0;
+	mScale = 1;
+	mPenDown = true;
+	mOpen = false;
+
+	mIndex.assign(0x10000, kNoShape);
+	for(uint32 a = 0; a < shapes.size(); a++)mIndex[shapes.number(a)] = a;
+}
+
+void Interpreter::setVertical(bool vertical)
+{
+	mVertical = vertical;
+}
+
+void Interpreter::run(uint32 index, Outline &outline)
+{
+	outline.clear();
+	mOutline = &outline;
+	mX = 0;
+	mY = 0;
+	mScale = 1;
+	mPenDown = true;
+	mOpen = false;
+	mStack.clear();
+
+	if(mUnicode)execute<true>(index, 0);
+	else execute<false>(index, 0);
+
+	outline.setAdvance((float)mX, (float)mY);
+	mOutline = nullptr;
+}
+
+template<bool kUnicode>
+void Interpreter::execute(uint32 index, uint32 depth)
+{
+	// The font information contains no commands.
+	if(mShapes.number(index) == 0)return;
+
+	const uint8* bytes = mShapes.buffer(index);
+	uint32 length = mShapes.defBytes(index);
+
+	uint32 position = 0;
+	while(position < length)
+	{
+		const uint8* command = bytes + position;
+		uint8 code = command[0];
+		if(code == 0)break;
+
+		position += commandSize<kUnicode>(bytes, position);
+
+		if(code > 0x0F)
+		{
+			double units = code >> 4;
+			moveBy(kDirections[code & 0x0F][0] * units, kDirections[code & 0x0F][1] * units);
+			continue;
+		}
+
+		switch(code)
+		{
+			case 1:
+				mPenDown = true;
+				break;
+
+			case 2:
+				mPenDown = false;
+				mOpen = false;
+				break;
+
+			case 3:
+				mScale /= command[1];
+				break;
+
+			case 4:
+				mScale *= command[1];
+				break;
+
+			case 5:
+				mStack.push_back(mX);
+				mStack.push_back(mY);
+				break;
+
+			case 6:
+				if(mStack.size() < 2)break;
+				mY = mStack.back();
+				mStack.pop_back();
+				mX = mStack.back();
+				mStack.pop_back();
+				mOpen = false;
+				break;
+
+			case 7:
+			{
+				uint16 number = kUnicode ? (uint16)((command[1] << 8) | command[2]) : command[1];
+				uint32 target = mIndex[number];
+				if(target == kNoShape)
+					throw jm::Exception("In shape \""
+					                    + mShapes.name(index)
+					                    + "\": Subshape "
+					                    + jm::String::valueOf((int64)number)
+					                    + " not found.");
+				if(depth >= kMaxDepth)
+					throw jm::Exception("In shape \""
+					                    + mShapes.name(index)
+					                    + "\": Subshapes are nested too deep.");
+				execute<kUnicode>(target, depth + 1);
+				break;
+			}
+
+			case 8:
+				moveBy((int8)command[1], (int8)command[2]);
+				break;
+
+			case 9:
+				for(const uint8* entry = command + 1; entry[0] != 0 || entry[1] != 0; entry += 2)
+					moveBy((int8)entry[0], (int8)entry[1]);
+				break;
+
+			case 10:
+			{
+				// (-)0SC: clockwise, start octant and count of octants, where 0 is a full circle
+				int32 start = (command[2] >> 4) & 0x07;
+				int32 count = command[2] & 0x07;
+				if(count == 0)count = 8;
+				bool clockwise = (command[2] & 0x80) != 0;
+
+				int32 end = clockwise ? start - count : start + count;
+				octantArc(command[1] * mScale, start * 256, end * 256);
+				break;
+			}
+
+			case 11:
+			{
+				// The offsets are given in 1/256 octant from the start octant and from the last
+				// octant. An end offset of 0 ends the arc at the boundary of the last octant.
+				int32 octant = (command[5] >> 4) & 0x07;
+				int32 count = command[5] & 0x07;
+				if(count == 0)count = 8;
+				int32 sign = (command[5] & 0x80) != 0 ? -1 : 1;
+
+				int32 start = octant * 256 + sign * command[1];
+				int32 end = (octant + sign * count) * 256;
+				if(command[2] != 0)end = (octant + sign * (count - 1)) * 256 + sign * command[2];
+				if(sign * (end - start) <= 0)end += sign * kFullCircle;
+
+				octantArc(((command[3] << 8) | command[4]) * mScale, start, end);
+				break;
+			}
+
+			case 12:
+				bulgeArc((int8)command[1] * mScale, (int8)command[2] * mScale, (int8)command[3]);
+				break;
+
+			case 13:
+				for(const uint8* entry = command + 1; entry[0] != 0 || entry[1] != 0; entry += 3)
+					bulgeArc((int8)entry[0] * mScale, (int8)entry[1] * mScale, (int8)entry[2]);
+				break;
+
+			case 14:
+				// The next command is only executed in vertical mode.
+				if(!mVertical && position < length && bytes[position] != 0)
+					position += commandSize<kUnicode>(bytes, position);
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
+/*!
+ \brief Moves the position by the displacement, which is scaled by the current scale factor.
+ */
+void Interpreter::moveBy(double dx, double dy)
+{
+	lineTo(mX + dx * mScale, mY + dy * mScale);
+}
+
+/*!
+ \brief Moves the position to the point and draws a segment, if the pen is down.
+ */
+void Interpreter::lineTo(double x, double y)
+{
+	if(mPenDown)
+	{
+		if(!mOpen)mOutline->moveTo((float)mX, (float)mY);
+		mOutline->lineTo((float)x, (float)y);
+		mOpen = true;
+	}
+	mX = x;
+	mY = y;
+}
+
+/*!
+ \brief Draws an arc from the current position around the center to the end point.
+ \param sweep The angle of the arc in steps, positive for counterclockwise arcs.
+ */
+void Interpreter::arc(double cx, double cy, double sweep, double x, double y)
+{
+	double vx = mX - cx;
+	double vy = mY - cy;
+	int32 sign = sweep < 0 ? -1 : 1;
+
+	// Segments shorter than 1/8 step are merged with the last segment.
+	double limit = std::fabs(sweep) - kArcStep / 8.0;
+	for(int32 angle = kArcStep; angle < limit; angle += kArcStep)
+	{
+		double c = cosine(sign * angle);
+		double s = sine(sign * angle);
+		lineTo(cx + vx * c - vy * s, cy + vx * s + vy * c);
+	}
+	lineTo(x, y);
+}
+
+/*!
+ \brief Draws an arc around the center, which is determined by the current position and the start
+ angle. The angles are given in steps, the end angle is less than the start angle for clockwise
+ arcs.
+ */
+void Interpreter::octantArc(double radius, int32 start, int32 end)
+{
+	double cx = mX - radius * cosine(start);
+	double cy = mY - radius * sine(start);
+
+	arc(cx, cy, end - start, cx + radius * cosine(end), cy + radius * sine(end));
+}
+
+/*!
+ \brief Draws an arc by the displacement. The bulge is the height of the arc relative to the half
+ chord multiplied by 127. Positive bulges are counterclockwise arcs, 0 is a straight line.
+ */
+void Interpreter::bulgeArc(double dx, double dy, int8 bulge)
+{
+	double chord = std::sqrt(dx * dx + dy * dy);
+	if(bulge == 0 || chord == 0)
+	{
+		lineTo(mX + dx, mY + dy);
+		return;
+	}
+
+	// The included angle and the distance of the center from the middle of the chord
+	double angle = 4 * std::atan(std::fabs(bulge) / 127.0);
+	double distance = chord / 2 / std::tan(angle / 2);
+	if(bulge < 0)distance = -distance;
+
+	double cx = mX + dx / 2 - dy / chord * distance;
+	double cy = mY + dy / 2 + dx / chord * distance;
+	double sweep = angle * kFullCircle / (2 * kPi);
+	if(bulge < 0)sweep = -sweep;
+
+	arc(cx, cy, sweep, mX + dx, mY + dy);
+}
@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Interpreter.h
+// Application: Shape File Compiler
+// Purpose:     Interpreter for spec bytes
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_Interpreter_h
+#define shpc_Interpreter_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+#include "Outline.h"
+#include "ShapeTable.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The interpreter executes the spec bytes of a shape and draws its outline. All commands
+	 are supported: vectors, pen up and down, scaling, the position stack, subshapes, lines, octant
+	 and fractional arcs and bulge arcs. Arcs are flattened into segments of 1/8 octant by a
+	 precomputed table of sines, whose angles are 1/256 octant apart like the offsets of the
+	 Fractional-Arc-Command (11).
+
+	 The pen is down at the start of a shape, the scale is 1. Subshapes are drawn with the state of
+	 the calling shape and may change it. A command after a Do-Next-Command (14) is only executed in
+	 vertical mode.
+	 */
+	class Interpreter
+	{
+		public:
+
+			// The number of steps of the angles of a full circle.
+			static const int32 kFullCircle = 2048;
+
+			// The angle of a segment of a flattened arc in steps.
+			static const int32 kArcStep = 32;
+
+			// The maximum nesting depth of subshapes. Deeper nesting is considered as a cycle.
+			static const uint32 kMaxDepth = 64;
+
+			/*!
+			 \brief Constructor. The shape table must exist during the lifetime of the interpreter and
+			 its spec bytes must be valid.
+			 */
+			Interpreter(const ShapeTable &shapes, bool unicode);
+
+			/*!
+			 \brief Status whether the commands for vertical text are executed. Default: false.
+			 */
+			void setVertical(bool vertical);
+
+			/*!
+			 \brief Returns the index of the shape with the number or 0xFFFFFFFF.
+			 */
+			uint32 find(uint16 number) const
+			{
+				return mIndex[number];
+			}
+
+			/*!
+			 \brief Draws the shape at the index into the outline. The outline is cleared before.
+			 \throws jm::Exception, if a subshape does not exist or is nested too deep.
+			 */
+			void run(uint32 index, Outline &outline);
+
+		private:
+
+			// The shapes.
+			const ShapeTable &mShapes;
+
+			// Status whether the font is a Unicode font.
+			bool mUnicode;
+
+			// Status whether the commands for vertical text are executed.
+			bool mVertical;
+
+			// The index of the shape of each shape number.
+			std::vector<uint32> mIndex;
+
+			// The outline, which is drawn.
+			Outline* mOutline;
+
+			// The current position.
+			double mX;
+			double mY;
+
+			// The current scale factor.
+			double mScale;
+
+			// Status whether the pen is down.
+			bool mPenDown;
+
+			// Status whether the last point of the outline is the current position, so that the next
+			// segment continues the polyline.
+			bool mOpen;
+
+			// The position stack.
+			std::vector<double> mStack;
+
+			template<bool kUnicode>
+			void execute(uint32 index, uint32 depth);
+
+			void moveBy(double dx, double dy);
+
+			void lineTo(double x, double y);
+
+			void arc(double cx, double cy, double sweep, double x, double y);
+
+			void octantArc(double radius, int32 start, int32 end);
+
+			void bulgeArc(double dx, double dy, int8 bulge);
+	};
+
+}
+
+#endif
@@ -29,26 +29,39 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <chrono>
+#include <iomanip>
 #include <iostream>
 #include <vector>
 
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
 #include "core/Core.h"
 
+#include "Batch.h"
+#include "Compiler.h"
+#include "FileWatcher.h"
+#include "FontDiff.h"
+#include "HeaderFile.h"
+#include "Merger.h"
+#include "MetricsFile.h"
+#include "Preview.h"
+#include "Server.h"
+#include "ShxDecompiler.h"
+#include "Subsetter.h"
+#include "Trace.h"
+
 const jm::String version = "Jameo SHP-Compiler V 1.3";
 const jm::String err = "<ERROR> ";
 const jm::String wrn = "<WARNING> ";
 const jm::String inf = "<INFO> ";
 
 /*!
- \brief The pointer to the file. Either when reading or writing.
- */
-jm::File* file;
-
-/*!
- \brief Status whether the end of the file was reached during reading. If it is set to "true", then
- the end was reached and the reading is finished.
+ \brief Exit code for options, which cannot be combined.
  */
-bool endOfFile;
+const int usageError = 2;
 
 /*!
  \brief Status whether detailed information is displayed.
@@ -56,9 +69,9 @@ bool endOfFile;
 bool verbose;
 
 /*!
- \brief Name of the input file.
+ \brief Names of the input files, directories or response files.
  */
-jm::String inputname;
+std::vector<jm::String> inputnames;
 
 /*!
  \brief Name of the output file.
@@ -66,665 +79,764 @@ jm::String inputname;
 jm::String outputname;
 
 /*!
- \brief Reference to the Windows encoding charset, because all strings are encoded with it in SHX
- files.
+ \brief Directory for the SHX files in batch mode.
+ */
+jm::String outputdir;
+
+/*!
+ \brief Number of threads for compilation. 0 means one per core.
+ */
+uint32 threads;
+
+/*!
+ \brief Status whether statistics are printed after the compilation.
  */
-jm::Charset* cs;
+bool stats;
+
+/*!
+ \brief The trace of the compilation or nullptr.
+ */
+shpc::Trace* trace = nullptr;
+
+/*!
+ \brief Duration of saving the SHX file in seconds.
+ */
+double saveTime;
+
+typedef std::chrono::steady_clock Clock;
+
+/*!
+ \brief Returns the seconds since the start.
+ */
+double secondsSince(const Clock::time_point &start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
 
 /*!
- \brief Helping structure for compiling.
+ \brief Returns the peak resident memory of the process in bytes or 0, if it is not known.
  */
-struct Shape
+uint64 peakMemory()
 {
-	//The shape number.
-	uint16 number;
+#ifdef _WIN32
+	return 0;
+#else
+	struct rusage usage;
+	if(getrusage(RUSAGE_SELF, &usage) != 0)return 0;
+#ifdef __APPLE__
+	return usage.ru_maxrss;
+#else
+	return (uint64)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
 
-	// Pointer to current byte during generation.
-	uint16 position;
+/*!
+ \brief Prints the statistics of the compilation.
+ \param times The phases, summed up over all files.
+ \param save The time for saving the files.
+ \param total The wall time of the whole compilation.
+ */
+void printStats(const shpc::PhaseTimes &times,
+                double save,
+                double total,
+                uint64 bytesIn,
+                uint64 bytesOut,
+                uint64 glyphs)
+{
+	std::cout << "Statistics:" << std::endl;
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << "  read        " << std::setw(12) << times.read * 1000 << " ms" << std::endl;
+	std::cout << "  tokenize    " << std::setw(12) << times.tokenize * 1000 << " ms" << std::endl;
+	std::cout << "  check       " << std::setw(12) << times.check * 1000 << " ms" << std::endl;
+	std::cout << "  write       " << std::setw(12) << times.write * 1000 << " ms" << std::endl;
+	std::cout << "  save        " << std::setw(12) << save * 1000 << " ms" << std::endl;
+	std::cout << "  total       " << std::setw(12) << total * 1000 << " ms" << std::endl;
+	std::cout << "  bytes in    " << std::setw(12) << bytesIn << std::endl;
+	std::cout << "  bytes out   " << std::setw(12) << bytesOut << std::endl;
+	std::cout << "  glyphs      " << std::setw(12) << glyphs << std::endl;
+	std::cout << "  peak RSS    " << std::setw(12) << peakMemory() / 1024 << " KiB" << std::endl;
+}
 
-	// Number of defbytes in shape.
-	uint16 defBytes;
+/*!
+ \brief Path of the UNIX domain socket of the compile server.
+ */
+jm::String socketpath;
 
-	// The name of the shape.
-	jm::String name;
+/*!
+ \brief Status whether unchanged shapes are taken from the cache file.
+ */
+bool incremental;
 
-	// The data.
-	uint8* buffer;
+/*!
+ \brief Status whether the subshapes are flattened.
+ */
+bool flatten;
 
-	Shape()
-	{
-		number = 0;
-		position = 0;
-		defBytes = 0;
-		buffer = nullptr;
-	}
+/*!
+ \brief Status whether the spec bytes are optimized.
+ */
+bool optimize;
 
-	~Shape()
-	{
-		if(buffer != nullptr)delete[] buffer;
-	}
-};
+/*!
+ \brief Status whether repeated runs of commands are moved into subshapes.
+ */
+bool deduplicate;
 
 /*!
- \brief String designation about the file type. This is also the string with which the file begins
- on the disk.
+ \brief Name of the file for the graph of the subshape references or empty.
  */
-jm::String filetype;
+jm::String graphname;
 
 /*!
- \brief There are two variants of how the shapes are stored in the file. One is Unicode and the
- other is "normal". With Unicode all shapes are packed together. With "normal" first header data for
- all shapes are written and then the shape descriptions".
+ \brief Name of the metrics sidecar file or empty.
  */
-bool isUnicode;
+jm::String metricsname;
 
 /*!
- \brief The shape that is currently being compiled.
+ \brief Name of the C++ header with the compiled font or empty.
  */
-Shape* current;
+jm::String headername;
 
 /*!
- \brief List with all shapes.
+ \brief Name of the preview image or empty.
  */
-std::vector<Shape*> shapes;
+jm::String previewname;
 
 /*!
- \brief Counts the shape definition lines during read-in
+ \brief Name of the file for the hashes of the preview tiles or empty.
  */
-uint32 shapeCount;
+jm::String hashesname;
 
 /*!
- \brief This method reads a line from the file and returns it. If the end of the file was reached,
- "endOfFile" is set to "true".
+ \brief Status whether SHX files are converted back into SHP files.
  */
-jm::String readLine()
-{
-	jm::String line;
+bool decompile;
 
-	while(true)
+/*!
+ \brief Status whether the input files are merged into one SHX file.
+ */
+bool merge;
+
+/*!
+ \brief The input, which wins for shapes with the same number in merge mode.
+ */
+shpc::MergePriority priority;
+
+/*!
+ \brief The list of shape numbers, which are kept in subset mode.
+ */
+jm::String subsetlist;
+
+/*!
+ \brief The text file, whose characters are kept in subset mode.
+ */
+jm::String subsettext;
+
+/*!
+ \brief Status whether two fonts are compared.
+ */
+bool diff;
+
+/*!
+ \brief Status whether the bounding boxes and advances are compared in diff mode.
+ */
+bool diffgeometry;
+
+/*!
+ \brief Prints the messages of the compiler.
+ */
+void printDiagnostics(const std::vector<shpc::Diagnostic> &diagnostics)
+{
+	for(size_t a = 0; a < diagnostics.size(); a++)
 	{
-		uint8 c;
-		int64 size = file->read(&c, 1);
-		if(size != 1)
+		const shpc::Diagnostic& diagnostic = diagnostics[a];
+		switch(diagnostic.severity)
 		{
-			endOfFile = true;
-			file->close();
-			return line;
-		}
+			case shpc::Severity::kInfo:
+				std::cout << inf;
+				break;
 
-		if(c != 10 && c != 13)
-		{
-			line.append(c);
+			case shpc::Severity::kWarning:
+				std::cout << wrn;
+				break;
+
+			case shpc::Severity::kError:
+				std::cout << err;
+				break;
 		}
-		else return line;
+		std::cout << diagnostic.message << std::endl;
 	}
-
 }
 
 /*!
- \brief This method removes comments from a line of the file. A comment starts with a semicolon and
- ends at the end of the line. So everything from the semicolon on is truncated.
+ \brief Renders the shapes in parallel and saves the preview image and the hashes of the tiles.
  */
-jm::String stripComment(const jm::String &line)
+void savePreview(const shpc::Compiler &compiler)
 {
-	jm::String stripped;
-	for(uint32 a = 0; a < line.size(); a++)
-	{
-		jm::Char c = line.charAt(a);
+	shpc::TraceSpan span(trace, "preview", "phase");
+	shpc::ThreadPool pool(threads);
 
-		// Everything after a semicolon is comment
-		if(c == ';')return stripped;
-		stripped.append(c);
-	}
-	return stripped;
+	shpc::Preview preview;
+	preview.setColor(previewname.endsWith(".ppm"));
+	preview.setThreadPool(&pool);
+	preview.render(compiler.shapes(), shpc::wideSubshapes(compiler.format()));
+
+	if(previewname.size() > 0)preview.save(previewname);
+	if(hashesname.size() > 0)preview.saveHashes(hashesname);
 }
 
 /*!
- \brief This method parses a byte definition
+ \brief Compiles the file and saves the SHX file and, if used, the cache.
  */
-uint8 toSpecByte(jm::String token)
+bool compileWith(shpc::Compiler &compiler, shpc::ShapeCache* cache, const jm::String &inputname)
 {
-	token = token.trim();
-	int32 sign = 1;
-	if(token.charAt(0) == jm::Char('-'))
+	bool success = false;
+	try
 	{
-		sign = -1;
-		token = token.substring(1);
-		token = token.trim();
-	}
-
-	int32 c=0;
-	if(token.charAt(0) == jm::Char('0'))
-	{
-		c =  jm::Integer::fromHex(token);
-		if(sign < 0)c |= 0x80;// Note: Yes exactly this operation.
+		jm::File file(inputname);
+		file.open(jm::FileMode::kRead);
+		success = compiler.compile(&file);
+		file.close();
+		printDiagnostics(compiler.diagnostics());
+		if(success)
+		{
+			Clock::time_point start = Clock::now();
+			shpc::TraceSpan span(trace, "save", "phase");
+			compiler.image().save(outputname);
+			if(cache != nullptr)cache->save(shpc::ShapeCache::filename(outputname));
+			if(graphname.size() > 0)compiler.graph().save(graphname, compiler.shapes());
+			if(metricsname.size() > 0)
+			{
+				shpc::MetricsFile metrics;
+				metrics.build(compiler.shapes(), shpc::wideSubshapes(compiler.format()));
+				metrics.save(metricsname);
+			}
+			if(headername.size() > 0)
+			{
+				const std::vector<uint8>& shx = compiler.image().data();
+				shpc::HeaderFile header;
+				header.build(shx.data(), shx.size(), shpc::HeaderFile::identifier(headername));
+				header.save(headername);
+			}
+			if(previewname.size() > 0 || hashesname.size() > 0)savePreview(compiler);
+			saveTime = secondsSince(start);
+		}
 	}
-	else
+	catch(jm::Exception& e)
 	{
-		c = token.toInt();
-		if(sign < 0)c *= -1;
+		std::cout << err << e.errorMessage() << std::endl;
+		success = false;
 	}
-	return c;
+	return success;
 }
 
 /*!
- \brief This method parses a byte definition
+ \brief Compiles a single file.
  */
-uint16 toSpecShort(jm::String token)
+int compileFile(const jm::String &inputname)
 {
-	token = token.trim();
+	// Determine the name of the output file
+	if(outputname.size() < 1)outputname = shpc::shxName(inputname);
 
-	if(token.charAt(0) == jm::Char('0'))
+	if(verbose)
 	{
-		return jm::Integer::fromHex(token);
+		std::cout << inf << "input file: " << inputname << std::endl;
+		std::cout << inf << "output file: " << outputname << std::endl;
 	}
-	else
+
+	jm::File file(inputname);
+
+	if(file.exists() == false)
 	{
-		return token.toInt();
+		std::cout << err << "Input file \"" << inputname << "\" does not exist" << std::endl;
+		return -1;
 	}
-}
 
-/*!
- \brief This method evaluates the header of a shape. Each shape definition starts with it. There can
- be many shapes / characters in one file.
- */
-void handleFirstLine(const jm::String &line)
-{
-	jm::StringTokenizer st = jm::StringTokenizer(line, ",", false);
+	Clock::time_point start = Clock::now();
+	shpc::TraceSpan span(trace, "compile", "file", inputname);
 
-	jm::String number = st.next();
-	jm::String count = st.next();
-	jm::String name = st.next();
+	// Large files are split into chunks, which are compiled in parallel.
+	shpc::ThreadPool pool(threads);
 
-	if(number.equalsIgnoreCase("*UNIFONT")) number = "0";
-	else if(number.startsWith("*"))number = number.substring(1);
-	else throw jm::Exception("* expected.");
+	shpc::Compiler compiler;
+	compiler.setVerbose(verbose);
+	compiler.setThreadPool(&pool);
+	compiler.setTrace(trace);
+	compiler.setFlatten(flatten);
+	compiler.setOptimize(optimize);
+	compiler.setDeduplicate(deduplicate);
 
-	if(verbose)
-		std::cout << inf << "Shape: " << number << ", Spec Bytes: " << count << ", Name: " << name << std::endl;
+	shpc::ShapeCache cache;
+	if(incremental)
+	{
+		try
+		{
+			cache.load(shpc::ShapeCache::filename(outputname));
+		}
+		catch(jm::Exception& e)
+		{
+			std::cout << err << e.errorMessage() << std::endl;
+			return -1;
+		}
+		compiler.setCache(&cache);
+	}
 
-	current = new Shape();
+	bool success = compileWith(compiler, incremental ? &cache : nullptr, inputname);
 
-	if(number.startsWith("0"))current->number = jm::Integer::fromHex(number);
-	else current->number = number.toInt();
+	if(stats)
+	{
+		double total = secondsSince(start);
+		printStats(compiler.times(),
+		           saveTime,
+		           total,
+		           compiler.inputSize(),
+		           success ? compiler.image().data().size() : 0,
+		           success ? compiler.shapes().size() : 0);
+	}
 
-	if(count.startsWith("0"))current->defBytes = jm::Integer::fromHex(count);
-	else current->defBytes = count.toInt();
+	if(!success)return -1;
 
-	current->name = name;
-	current->buffer = new uint8[current->defBytes];
-	current->position = 0;
-	shapes.push_back(current);
+	if(verbose) std::cout << inf << "Output file created: " << outputname << std::endl;
+	std::cout << "Done." << std::endl;
+	return 0;
 }
 
 /*!
- \brief This method evaluates a specbyte line. The specbyte lines contain the geometry information
- for a shape. A shape can contain several such lines.
+ \brief Compiles the file again after each change. Only the changed shapes are compiled, so only
+ their messages are printed.
  */
-void handleDefinitionLine(const jm::String &line)
+int watchFile(const jm::String &inputname)
 {
-	if(current == nullptr)throw jm::Exception("Corrupt file. Shape header not found.");
+	if(outputname.size() < 1)outputname = shpc::shxName(inputname);
 
-	jm::StringTokenizer st = jm::StringTokenizer(line, ",()", false);
+	shpc::ThreadPool pool(threads);
 
-	while(st.hasNext())
-	{
-		jm::String token = st.next().trim();
+	shpc::ShapeCache cache;
 
-		if(current->position >= current->defBytes)
-			throw jm::Exception("Too many spec bytes in shape: " + current->name);
+	shpc::Compiler compiler;
+	compiler.setVerbose(verbose);
+	compiler.setThreadPool(&pool);
+	compiler.setCache(&cache);
+	compiler.setFlatten(flatten);
+	compiler.setOptimize(optimize);
+	compiler.setDeduplicate(deduplicate);
+
+	try
+	{
+		cache.load(shpc::ShapeCache::filename(outputname));
+		shpc::FileWatcher watcher(inputname);
 
-		if(token.size() > 4)
+		while(true)
 		{
-			uint16 s = toSpecShort(token);
-			current->buffer[current->position++] = (uint8)(s >> 8);
-			current->buffer[current->position++] = (uint8)(s);
+			Clock::time_point start = Clock::now();
+			bool success = compileWith(compiler, &cache, inputname);
+			Clock::duration duration = Clock::now() - start;
+
+			int64 ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+			if(success)
+			{
+				uint32 changed = compiler.shapes().size() - compiler.cachedShapes();
+				std::cout << "Done in " << ms << " ms, " << changed << " changed shapes." << std::endl;
+			}
+			else std::cout << "Failed in " << ms << " ms." << std::endl;
+			std::cout << "Waiting for changes of " << inputname << " ..." << std::endl;
+
+			watcher.wait();
 		}
-		else current->buffer[current->position++] = toSpecByte(token);
 	}
+	catch(jm::Exception& e)
+	{
+		std::cout << err << e.errorMessage() << std::endl;
+	}
+	return -1;
 }
 
 /*!
- \brief This method parses a compiled shape or its SpecBytes for errors in content.
+ \brief Checks, that no option for a single output file is given in batch mode. Each input gets
+ its own SHX file, so these options would be ignored.
+ \return true, if the options can be used in batch mode.
  */
-void parse(Shape* shape)
+bool checkBatchOptions()
 {
-	int a = 0;
-	int stack = 0;
-	while(a < shape->defBytes)
-	{
-		uint8 c1, c2;//, c3, c4, c5;
-
-		uint8 c = shape->buffer[a];
-
-		switch(c)
-		{
-			case 0: // End of Shape
-				// "End of Shape" may only be the last byte in a shape definition.
-				if(a != (shape->defBytes - 1))
-					throw jm::Exception("In shape \""
-					                    + shape->name
-					                    + "\": End-Of-Shape-Command (0) before end of shape found.");
-				break;
-
-			case 1: // Pen Down
-				// Here is nothing to do.
-				break;
-
-			case 2: // Pen Up
-				// Here is nothing to do.
-				break;
-
-			case 3:
-				if((a + 1) >= (shape->defBytes - 1))
-					throw jm::Exception("In shape \""
-					                    + shape->name
-					                    + "\": Scale-Down-Command (3) not complete.");
-				c1 = shape->buffer[a + 1];
-				//! \todo Are there limits to values ???
-				a++;
-				break;
-
-			case 4:
-				if((a + 1) >= (shape->defBytes - 1))
-					throw jm::Exception("In shape \""
-					                    + shape->name
-					                    + "\": Scale-Up-Command (4) not complete.");
-				c1 = shape->buffer[a + 1];
-				//! \todo Are there limits to values ???
-				a++;
-				break;
-
-			case 5:
-				stack++;
-				if(stack > 4)
-					throw jm::Exception("In shape \"" + shape->name + "\": Too many Push-Commands (5).");
-				break;
-
-			case 6:
-				stack--;
-				if(stack < 0)
-					throw jm::Exception("In shape \"" + shape->name + "\": Too many Pop-Commands (6).");
-				break;
+	const char* option = nullptr;
+	if(outputname.size() > 0)option = "-o";
+	else if(graphname.size() > 0)option = "--graph";
+	else if(metricsname.size() > 0)option = "--metrics";
+	else if(headername.size() > 0)option = "--header";
+	else if(previewname.size() > 0)option = "--preview";
+	else if(hashesname.size() > 0)option = "--preview-hashes";
+	if(option == nullptr)return true;
+
+	std::cout << err << option << " cannot be used with several input files. Use -d <dir> for "
+	          << "the output files." << std::endl;
+	return false;
+}
 
-			case 7:
-				if(isUnicode)
-				{
-					if((a + 2) >= (shape->defBytes - 1))
-						throw jm::Exception("In shape \""
-						                    + shape->name
-						                    + "\": Subshape-Command (7) not complete.");
-					c1 = shape->buffer[a + 1];
-					c2 = shape->buffer[a + 2];
-					//! \todo Are there limits to values ???
-					a += 2;
-				}
-				else
-				{
-					if((a + 1) >= (shape->defBytes - 1))
-						throw jm::Exception("In shape \""
-						                    + shape->name
-						                    + "\": Subshape-Command (4) not complete.");
-					c1 = shape->buffer[a + 1];
-					//! \todo Are there limits to values ???
-					a++;
-				}
-				break;
+/*!
+ \brief Compiles all input files in parallel and prints a summary.
+ */
+int compileBatch()
+{
+	shpc::Batch batch;
+	batch.setVerbose(verbose);
+	batch.setOutputDirectory(outputdir);
+	batch.setIncremental(incremental);
+	batch.setFlatten(flatten);
+	batch.setOptimize(optimize);
+	batch.setDeduplicate(deduplicate);
+	batch.setTrace(trace);
+
+	try
+	{
+		for(size_t a = 0; a < inputnames.size(); a++)batch.add(inputnames[a]);
+	}
+	catch(jm::Exception& e)
+	{
+		std::cout << err << e.errorMessage() << std::endl;
+		return -1;
+	}
 
-			case 8:
-				if((a + 2) >= (shape->defBytes - 1))
-					throw jm::Exception("In shape \""
-					                    + shape->name
-					                    + "\": Line-To-Command (8) not complete.");
-				c1 = shape->buffer[a + 1];
-				c2 = shape->buffer[a + 2];
-				//! \todo Are there limits to values ???
-				a += 2;
-				break;
+	Clock::time_point start = Clock::now();
 
-			case 9:
-				do
-				{
-					if((a + 2) >= (shape->defBytes - 1))
-						throw jm::Exception("In shape \""
-						                    + shape->name
-						                    + "\": Multi-Line-To-Command (9) not complete.");
-					c1 = shape->buffer[a + 1];
-					c2 = shape->buffer[a + 2];
-					a += 2;
-					//						if( ( c1 != 0 || c2 != 0 ) ) ;//Wertegrenezn für lineto
-				}
-				while(c1 != 0 || c2 != 0);
-				break;
-
-			case 10:
-				if((a + 2) >= (shape->defBytes - 1))
-					throw jm::Exception("In shape \""
-					                    + shape->name
-					                    + "\": Octant-Arc-Command (10) not complete.");
-				c1 = shape->buffer[a + 1];
-				c2 = shape->buffer[a + 2];
-				//! \todo Are there limits to values ???
-				a += 2;
-				break;
+	shpc::ThreadPool pool(threads);
+	if(verbose)
+		std::cout << inf << "Compile " << batch.size() << " files with "
+		          << pool.size() << " threads." << std::endl;
 
-			case 11:
-				if((a + 5) >= (shape->defBytes - 1))
-					throw jm::Exception("In shape \""
-					                    + shape->name
-					                    + "\": Fractional-Arc-Command (11) not complete.");
-				c1 = shape->buffer[a + 1];
-				c2 = shape->buffer[a + 2];
-				//c3 = shape->buffer[a + 3];
-				//c4 = shape->buffer[a + 4];
-				//c5 = shape->buffer[a + 5];
-				//! \todo Are there limits to values ???
-				a += 5;
-				break;
+	batch.run(pool);
 
-			case 12:
-				if((a + 3) >= (shape->defBytes - 1))
-					throw jm::Exception("In shape \""
-					                    + shape->name
-					                    + "\": Arc-To-Command (12) not complete.");
-				c1 = shape->buffer[a + 1];
-				c2 = shape->buffer[a + 2];
-				//c3 = shape->buffer[a + 3];
-				//! \todo Are there limits to values ???
-				a += 3;
-				break;
+	double total = secondsSince(start);
 
-			case 13:
-				do
-				{
-					if((a + 2) >= (shape->defBytes - 1))
-						throw jm::Exception("In shape \""
-						                    + shape->name
-						                    + "\": Multi-Arc-To-Command (13) not complete.");
-					c1 = shape->buffer[a + 1];
-					c2 = shape->buffer[a + 2];
-					//c3 = shape->buffer[a + 3];
-					a += 2;
-					if((c1 != 0 || c2 != 0))
-					{
-						if((a + 1) >= (shape->defBytes - 1))
-							throw jm::Exception("In shape \""
-							                    + shape->name
-							                    + "\": Multi-Arc-To-Command (13) not complete.");
-						a++;
-					}
-				}
-				while(c1 != 0 || c2 != 0);
-				break;
+	const std::vector<shpc::BatchResult>& results = batch.results();
+	for(size_t a = 0; a < results.size(); a++)
+	{
+		const shpc::BatchResult& result = results[a];
+		if(result.success)
+			std::cout << "OK     " << result.input << " -> " << result.output << std::endl;
+		else std::cout << "FAILED " << result.input << std::endl;
+		printDiagnostics(result.diagnostics);
+	}
 
-			case 14:
-				if((a + 1) >= (shape->defBytes - 1))
-					throw jm::Exception("In shape \""
-					                    + shape->name
-					                    + "\": No command after Do-Next-Command (14).");
-				break;
+	uint32 failures = batch.failures();
+	std::cout << (batch.size() - failures) << " of " << batch.size()
+	          << " files compiled." << std::endl;
 
-			default:
-				c1 = c & 0x0F;
-				c2 = (c >> 4) & 0x0F;
-				// Can only occur for 0x0F
-				if(c2 == 0x0)
-					throw jm::Exception("In shape \""
-					                    + shape->name
-					                    + "\": Vector length is zero (00).");
-				break;
+	if(stats)
+	{
+		shpc::PhaseTimes times;
+		double save = 0;
+		uint64 bytesIn = 0;
+		uint64 bytesOut = 0;
+		uint64 glyphs = 0;
+		for(size_t a = 0; a < results.size(); a++)
+		{
+			const shpc::BatchResult& result = results[a];
+			times.read += result.times.read;
+			times.tokenize += result.times.tokenize;
+			times.check += result.times.check;
+			times.write += result.times.write;
+			save += result.save;
+			bytesIn += result.bytesIn;
+			bytesOut += result.bytesOut;
+			glyphs += result.glyphs;
 		}
-		a++;
+		printStats(times, save, total, bytesIn, bytesOut, glyphs);
 	}
+
+	return failures == 0 ? 0 : -1;
 }
 
 /*!
- \brief This method checks if all names contain only numbers and capital letters.
+ \brief Converts the SHX files back into SHP files. The SHP file is written next to the SHX file,
+ unless an output file is given for a single input.
  */
-void checkShapeName(const jm::String &name)
+int decompileFiles()
 {
-	for(uint32 a = 0; a < name.size(); a++)
+	shpc::ThreadPool pool(threads);
+
+	int result = 0;
+	for(size_t a = 0; a < inputnames.size(); a++)
 	{
-		jm::Char c = name.charAt(a);
+		const jm::String& inputname = inputnames[a];
 
-		if((c < '0' || c > '9') && (c < 'A' || c > 'Z'))
+		jm::String output = outputname;
+		bool named = output.size() > 0 && inputnames.size() == 1;
+		if(!named)
 		{
-			std::cout << wrn
-			     << "In shape \""
-			     << name
-			     << "\": Characters of name should be upper case or numbers." << std::endl;
-			return;
+			output = inputname;
+			if(output.toLowerCase().endsWith(".shx"))output = output.substring(0, output.size() - 4);
+			output.append(".shp");
 		}
 
+		try
+		{
+			shpc::TraceSpan span(trace, "decompile", "file", inputname);
+
+			// The source of the font is usually next to it and must not be lost.
+			if(!named && jm::File(output).exists())
+				throw jm::Exception("Output file \"" + output
+				                    + "\" exists. Use -o <name> to overwrite it.");
+
+			shpc::ShxDecompiler decompiler;
+			decompiler.setThreadPool(&pool);
+			decompiler.load(inputname);
+			decompiler.decompile();
+			decompiler.save(output);
+
+			if(verbose)
+				std::cout << inf << decompiler.size() << " Shapes decompiled." << std::endl;
+			std::cout << "OK     " << inputname << " -> " << output << std::endl;
+		}
+		catch(jm::Exception& e)
+		{
+			std::cout << err << e.errorMessage() << std::endl;
+			std::cout << "FAILED " << inputname << std::endl;
+			result = -1;
+		}
 	}
+	return result;
 }
 
 /*!
- \brief This method checks the shapes for potential errors.
+ \brief Merges the shapes of all input files into the output file.
  */
-void check()
+int mergeFiles()
 {
-	int last = -1;
-
-	if(shapeCount != shapes.size())throw jm::Exception("Shape count differs from found shapes.");
-
-	for(uint32 a = 0; a < shapes.size(); a++)
+	if(outputname.size() < 1)
 	{
-		Shape* shape = shapes[a];
-		// Check shape name for "non-fonts"
-		if(shapes[0]->number != 0)checkShapeName(shape->name);
-
-		// Check that each shape ends with 0.
-		if(shape->buffer[shape->defBytes - 1] != 0)
-			throw jm::Exception("In shape \"" + shape->name + "\": Last spec byte must be 0.");
+		std::cout << err << "No output file for merging. Use -o <name>." << std::endl;
+		return -1;
+	}
 
-		// Check if the specified number of bytes matches the actually specified spec bytes.
-		if(shape->defBytes != shape->position)
-			throw jm::Exception("In shape \"" + shape->name + "\": Wrong spec byte count.");
+	shpc::ThreadPool pool(threads);
 
-		// Check that the shape numbers are ascending (and unique).
-		if(shape->number <= last)
-			throw jm::Exception("In shape \""
-			                    + shape->name
-			                    + "\": Number of shape is lower or equal than in shape before.");
-		last = shape->number;
+	shpc::Merger merger;
+	merger.setVerbose(verbose);
+	merger.setThreadPool(&pool);
+	merger.setPriority(priority);
+	for(size_t a = 0; a < inputnames.size(); a++)merger.add(inputnames[a]);
 
-		parse(shape);
+	bool success;
+	{
+		shpc::TraceSpan span(trace, "merge", "phase");
+		success = merger.run();
 	}
-}
+	printDiagnostics(merger.diagnostics());
+	if(!success)return -1;
 
-/*!
- \brief Writes a 16-bit number LE (little endian) encoded
- */
-void writeLE16(int16 value)
-{
-	uint8 c[2];
-	c[0] = (uint8)value;
-	c[1] = (uint8)(value >> 8);
-	file->write(c, 2);
-}
+	try
+	{
+		shpc::TraceSpan span(trace, "save", "phase");
+		merger.image().save(outputname);
+	}
+	catch(jm::Exception& e)
+	{
+		std::cout << err << e.errorMessage() << std::endl;
+		return -1;
+	}
 
-/*!
- \brief Writes a 16-bit number BE (big endian) encoded
- */
-void writeBE16(int16 value)
-{
-	uint8 c[2];
-	c[0] = (uint8)(value >> 8);
-	c[1] = (uint8)value;
-	file->write(c, 2);
+	if(verbose) std::cout << inf << "Output file created: " << outputname << std::endl;
+	std::cout << "Done." << std::endl;
+	return 0;
 }
 
 /*!
- \brief This method writes the SHX file in Unicode format.
+ \brief Writes the shapes of the input file, which are selected by the list or the text file, into
+ the output file.
  */
-void writeUnicodeSHX()
+int subsetFile()
 {
-	if(verbose) std::cout << inf << "Write file in UNICODE file format." << std::endl;
-	file = new jm::File(outputname);
-
-	file->open(jm::FileMode::kWrite);
-
-	jm::ByteArray cstring = filetype.toCString(cs);
-	file->write((uint8*)cstring.constData(), filetype.size());
-
-	// Write number of shapes
-	uint16 size = (uint16)shapes.size();
-	writeLE16(size);
-
-	// Write shapes
-	for(uint32 a = 0; a < shapes.size(); a++)
+	if(inputnames.size() != 1)
 	{
-		Shape* shape = shapes[a];
+		std::cout << err << "Only a single file can be subset." << std::endl;
+		return -1;
+	}
+	if(outputname.size() < 1)
+	{
+		std::cout << err << "No output file for the subset. Use -o <name>." << std::endl;
+		return -1;
+	}
 
-		// Shape number
-		writeLE16(shape->number);
+	shpc::ThreadPool pool(threads);
 
-		// Buffer length
-		writeLE16(shape->defBytes + shape->name.size() + 1);
+	shpc::Subsetter subsetter;
+	subsetter.setVerbose(verbose);
+	subsetter.setThreadPool(&pool);
 
-		// Shape name
-		cstring = shape->name.toCString(cs);
-		file->write((uint8*)cstring.constData(), shape->name.size() + 1);
+	try
+	{
+		if(subsetlist.size() > 0)subsetter.select(subsetlist);
+		if(subsettext.size() > 0)subsetter.selectTextFile(subsettext);
+	}
+	catch(jm::Exception& e)
+	{
+		std::cout << err << e.errorMessage() << std::endl;
+		return -1;
+	}
 
-		// Buffer
-		file->write(shape->buffer, shape->defBytes);
+	bool success;
+	{
+		shpc::TraceSpan span(trace, "subset", "phase");
+		success = subsetter.run(inputnames[0]);
+	}
+	printDiagnostics(subsetter.diagnostics());
+	if(!success)return -1;
 
+	try
+	{
+		shpc::TraceSpan span(trace, "save", "phase");
+		subsetter.image().save(outputname);
+	}
+	catch(jm::Exception& e)
+	{
+		std::cout << err << e.errorMessage() << std::endl;
+		return -1;
 	}
 
-	if(verbose) std::cout << inf << shapes.size() << " Shapes compiled." << std::endl;
 	if(verbose) std::cout << inf << "Output file created: " << outputname << std::endl;
+	std::cout << "Done." << std::endl;
+	return 0;
 }
 
-
 /*!
- \brief This method writes the SHX file in normal format.
+ \brief Compares the first input file with the second one and prints the differences or saves
+ them into the output file.
+ \return 0, if the fonts are equal, 1 if they differ and 2 on errors, like diff.
  */
-void writeNormalSHX()
+int diffFiles()
 {
-	if(verbose) std::cout << inf << "Write file in NORMAL file format." << std::endl;
-	file = new jm::File(outputname);
-
-	file->open(jm::FileMode::kWrite);
-
-
-	// Write file type
-	jm::ByteArray cstring = filetype.toCString(cs);
-	file->write((uint8*)cstring.constData(), filetype.size());
-
-	//Write lowest shape number
-	uint16 low = shapes[0]->number;
-	writeLE16(low);
+	if(inputnames.size() != 2)
+	{
+		std::cout << err << "Two files are needed for the comparison." << std::endl;
+		return 2;
+	}
 
-	// Write highest shape number
-	uint16 high = shapes[shapes.size() - 1]->number;
-	writeLE16(high);
+	shpc::ThreadPool pool(threads);
 
-	// Write number of shapes encoded
-	uint16 size = (uint16)shapes.size();
-	writeLE16(size);
+	shpc::FontDiff fontdiff;
+	fontdiff.setVerbose(verbose);
+	fontdiff.setThreadPool(&pool);
+	fontdiff.setGeometry(diffgeometry);
 
-	// Write shape header
-	for(uint32 a = 0; a < shapes.size(); a++)
+	bool success;
 	{
-		Shape* shape = shapes[a];
-
-		// shape number
-		writeLE16(shape->number);
-
-		// buffer length
-		writeLE16(shape->defBytes + shape->name.size() + 1);
+		shpc::TraceSpan span(trace, "diff", "phase");
+		success = fontdiff.run(inputnames[0], inputnames[1]);
 	}
+	printDiagnostics(fontdiff.diagnostics());
+	if(!success)return 2;
 
-	// Write shape data
-	for(uint32 a = 0; a < shapes.size(); a++)
+	if(outputname.size() > 0)
 	{
-		Shape* shape = shapes[a];
-
-		//Shapename
-		cstring = shape->name.toCString(cs);
-		file->write((uint8*)cstring.constData(), shape->name.size() + 1);
+		try
+		{
+			fontdiff.save(outputname);
+		}
+		catch(jm::Exception& e)
+		{
+			std::cout << err << e.errorMessage() << std::endl;
+			return 2;
+		}
+		if(verbose) std::cout << inf << "Output file created: " << outputname << std::endl;
+	}
+	else std::cout << fontdiff.text();
 
-		//Puffer
-		file->write(shape->buffer, shape->defBytes);
+	return fontdiff.equal() ? 0 : 1;
+}
 
-	}
+/*!
+ \brief Answers compile requests on stdin/stdout or, if a path is given, on the UNIX domain socket.
+ */
+int runServer()
+{
+	shpc::ThreadPool pool(threads);
 
-	//Write End-Of-File
-	file->write((uint8*)"EOF", 3);
+	shpc::Server server;
+	server.setThreadPool(&pool);
 
-	if(verbose) std::cout << inf << shapes.size() << " Shapes compiled: " << outputname << std::endl;
-	if(verbose) std::cout << inf << "Output file created: " << outputname << std::endl;
+	try
+	{
+		if(socketpath.size() > 0)
+		{
+			std::cout << inf << "Listening on " << socketpath << std::endl;
+			server.listen(socketpath);
+		}
+		else server.serve(0, 1);
+	}
+	catch(jm::Exception& e)
+	{
+		// On stdin/stdout only stderr is free for messages.
+		std::cerr << err << e.errorMessage() << std::endl;
+		return -1;
+	}
+	return 0;
 }
 
 /*!
- \brief This method traverses the file and controls the compilation as a whole.
+ \brief Compiles the input files with the compile server on the UNIX domain socket.
  */
-void compile()
+int compileRemote()
 {
-	shapeCount = 0;
-
-	while(!endOfFile)
+	int result = 0;
+	try
 	{
-		jm::String line = readLine();
-		if(line.size() > 128) std::cout << wrn << "Line is longer then 128 Bytes." << std::endl;
-		line = stripComment(line);
+		shpc::Client client;
+		client.connect(socketpath);
 
-		if(line.size() > 0)
+		for(size_t a = 0; a < inputnames.size(); a++)
 		{
-			if(line.charAt(0) == '*')
+			const jm::String& inputname = inputnames[a];
+			jm::File file(inputname);
+			if(!file.exists())
 			{
-				// First line in the SHP file determines what it is.
-				//
-				if(shapeCount == 0)
-				{
-					if(line.startsWith("*UNIFONT,"))
-					{
-						filetype = "AutoCAD-86 unifont 1.0\r\n\x1A";
-						isUnicode = true;
-					}
-					else if(line.startsWith("*0,"))
-					{
-						filetype = "AutoCAD-86 shapes 1.1\r\n\x1A";
-						isUnicode = false;
-					}
-					else
-					{
-						filetype = "AutoCAD-86 shapes 1.0\r\n\x1A";
-						isUnicode = false;
-					}
-				}
-				handleFirstLine(line);
-				shapeCount++;
+				std::cout << err << "Input file \"" << inputname << "\" does not exist" << std::endl;
+				result = -1;
+				continue;
 			}
-			else handleDefinitionLine(line);
-		}
-	}
 
-	check();
-	file->close();
-	delete file;
+			file.open(jm::FileMode::kRead);
+			shpc::ShpReader reader;
+			reader.load(&file);
+			file.close();
 
-	if(isUnicode)writeUnicodeSHX();
-	else writeNormalSHX();
-}
+			std::vector<uint8> shx;
+			std::vector<shpc::Diagnostic> diagnostics;
+			bool success = client.compile(reader.data(), reader.size(), verbose, shx, diagnostics);
+			printDiagnostics(diagnostics);
 
-/*!
-\brief Cleans allocated memory
-*/
-void clean()
-{
+			if(!success)
+			{
+				std::cout << "FAILED " << inputname << std::endl;
+				result = -1;
+				continue;
+			}
+
+			jm::String output = outputname;
+			if(output.size() < 1 || inputnames.size() > 1)output = shpc::shxName(inputname, outputdir);
 
-	// Clean shapes
-	for(uint32 a = 0; a < shapes.size(); a++)
+			try
+			{
+				shpc::ShxImage image;
+				image.allocate((uint32)shx.size());
+				image.write(shx.data(), (uint32)shx.size());
+				image.save(output);
+				std::cout << "OK     " << inputname << " -> " << output << std::endl;
+			}
+			catch(jm::Exception& e)
+			{
+				std::cout << err << e.errorMessage() << std::endl;
+				std::cout << "FAILED " << inputname << std::endl;
+				result = -1;
+			}
+		}
+	}
+	catch(jm::Exception& e)
 	{
-		delete shapes[a];
+		std::cout << err << e.errorMessage() << std::endl;
+		return -1;
 	}
-
-	// Clean file
-	file->close();
-	delete file;
-	file = nullptr;
+	return result;
 }
 
 /*!
@@ -732,17 +844,38 @@ void clean()
  */
 int main(int argc, const char* argv[])
 {
-	current = nullptr;
-	file = nullptr;
 	jm::System::init(jm::kEmptyString); // No bundle ref is we do not use any resources.
-	cs = jm::Charset::forName("Windows-1252");
-	std::cout << version << std::endl;
+
+	// On stdin/stdout the server writes only responses.
+	bool serverMode = false;
+	for(int a = 1; a < argc; a++)
+	{
+		if(jm::String(argv[a]).equals("--serve"))serverMode = true;
+	}
+	if(!serverMode)std::cout << version << std::endl;
 
 	bool printHelp = false;
+	bool batchMode = false;
+	bool watchMode = false;
+	bool listenMode = false;
+	bool connectMode = false;
 	verbose = false;
+	incremental = false;
+	flatten = false;
+	optimize = false;
+	deduplicate = false;
+	decompile = false;
+	merge = false;
+	diff = false;
+	diffgeometry = false;
+	priority = shpc::MergePriority::kFirst;
+	stats = false;
+	saveTime = 0;
+	jm::String tracename;
+	threads = 0;
 
 	// Evaluate arguments
-	for(int a = 0; a < argc; a++)
+	for(int a = 1; a < argc; a++)
 	{
 		jm::String cmd = argv[a];
 		if(cmd.equals("-o"))
@@ -758,6 +891,146 @@ int main(int argc, const char* argv[])
 				return 1;
 			}
 		}
+		else if(cmd.equals("-d"))
+		{
+			if(a < argc - 1)
+			{
+				outputdir = argv[++a];
+				batchMode = true;
+			}
+			else
+			{
+				std::cout << err << "No output directory after -d" << std::endl;
+				jm::System::quit();
+				return 1;
+			}
+		}
+		else if(cmd.equals("-j"))
+		{
+			if(a < argc - 1)
+			{
+				threads = (uint32)jm::String(argv[++a]).toInt();
+			}
+			else
+			{
+				std::cout << err << "No number of threads after -j" << std::endl;
+				jm::System::quit();
+				return 1;
+			}
+		}
+		else if(cmd.equals("-O"))
+		{
+			optimize = true;
+		}
+		else if(cmd.equals("-b"))
+		{
+			batchMode = true;
+		}
+		else if(cmd.equals("--serve"))
+		{
+			// Already evaluated above
+		}
+		else if(cmd.equals("--listen") || cmd.equals("--connect"))
+		{
+			if(a < argc - 1)
+			{
+				socketpath = argv[++a];
+				if(cmd.equals("--listen"))listenMode = true;
+				else connectMode = true;
+			}
+			else
+			{
+				std::cout << err << "No socket after " << cmd << std::endl;
+				jm::System::quit();
+				return 1;
+			}
+		}
+		else if(cmd.equals("--preview") || cmd.equals("--preview-hashes"))
+		{
+			if(a < argc - 1)
+			{
+				if(cmd.equals("--preview"))previewname = argv[++a];
+				else hashesname = argv[++a];
+			}
+			else
+			{
+				std::cout << err << "No file after " << cmd << std::endl;
+				jm::System::quit();
+				return 1;
+			}
+		}
+		else if(cmd.startsWith("--preview="))
+		{
+			previewname = cmd.substring(10);
+		}
+		else if(cmd.startsWith("--preview-hashes="))
+		{
+			hashesname = cmd.substring(17);
+		}
+		else if(cmd.equals("--stats"))
+		{
+			stats = true;
+		}
+		else if(cmd.startsWith("--trace="))
+		{
+			tracename = cmd.substring(8);
+		}
+		else if(cmd.equals("--flatten"))
+		{
+			flatten = true;
+		}
+		else if(cmd.equals("--dedup"))
+		{
+			deduplicate = true;
+		}
+		else if(cmd.equals("--decompile"))
+		{
+			decompile = true;
+		}
+		else if(cmd.equals("--merge") || cmd.equals("--merge=first"))
+		{
+			merge = true;
+			priority = shpc::MergePriority::kFirst;
+		}
+		else if(cmd.equals("--merge=last"))
+		{
+			merge = true;
+			priority = shpc::MergePriority::kLast;
+		}
+		else if(cmd.equals("--diff") || cmd.equals("--diff=geometry"))
+		{
+			diff = true;
+			diffgeometry = cmd.equals("--diff=geometry");
+		}
+		else if(cmd.startsWith("--subset="))
+		{
+			subsetlist = cmd.substring(9);
+		}
+		else if(cmd.startsWith("--subset-text="))
+		{
+			subsettext = cmd.substring(14);
+		}
+		else if(cmd.startsWith("--graph="))
+		{
+			graphname = cmd.substring(8);
+		}
+		else if(cmd.startsWith("--metrics="))
+		{
+			metricsname = cmd.substring(10);
+		}
+		else if(cmd.startsWith("--header="))
+		{
+			headername = cmd.substring(9);
+		}
+		else if(cmd.equals("--cache"))
+		{
+			incremental = true;
+		}
+		else if(cmd.equals("--watch"))
+		{
+			watchMode = true;
+			incremental = true;
+		}
 		else if(cmd.equals("-v"))
 		{
 			verbose = true;
@@ -771,9 +1044,9 @@ int main(int argc, const char* argv[])
 			std::cout << "App starts as expected without processing any file." << std::endl;
 			return 0;
 		}
-		else if(a == (argc - 1))
+		else
 		{
-			inputname = cmd;
+			inputnames.push_back(cmd);
 		}
 	}
 
@@ -782,10 +1055,50 @@ int main(int argc, const char* argv[])
 	{
 		std::cout << std::endl;
 		std::cout << "usage: shpc [options] *.shp" << std::endl;
+		std::cout << "       shpc [options] <file|directory|@responsefile> ..." << std::endl;
+		std::cout << "       shpc --decompile [-o <name>] *.shx ..." << std::endl;
+		std::cout << "       shpc --merge -o <name> <file.shp|file.shx> ..." << std::endl;
+		std::cout << "       shpc --subset=<list> [--subset-text=<file>] -o <name> <file>"
+		          << std::endl;
+		std::cout << "       shpc --diff[=geometry] [-o <name>] <old> <new>" << std::endl;
 		std::cout << "options:" << std::endl;
 		std::cout << "-h,-H     : Print help." << std::endl;
 		std::cout << "-v        : Print detailed information." << std::endl;
 		std::cout << "-o <name> : Name of output file." << std::endl;
+		std::cout << "-O        : Optimize the spec bytes and print the savings." << std::endl;
+		std::cout << "-b        : Batch mode, also for a single file." << std::endl;
+		std::cout << "-d <dir>  : Directory of the output files in batch mode." << std::endl;
+		std::cout << "-j <n>    : Number of threads (default: one per core)." << std::endl;
+		std::cout << "--cache   : Reuse unchanged shapes from the file <output>.cache." << std::endl;
+		std::cout << "--watch   : Compile the file again after each change (Linux)." << std::endl;
+		std::cout << "--flatten : Replace subshape references by the subshapes." << std::endl;
+		std::cout << "--dedup   : Move repeated runs of commands into subshapes." << std::endl;
+		std::cout << "--decompile : Convert SHX files back into SHP files." << std::endl;
+		std::cout << "--merge[=first|last] : Merge SHP and SHX files into the output file. For shapes"
+		          << std::endl;
+		std::cout << "            with the same number the first (default) or last file wins."
+		          << std::endl;
+		std::cout << "--subset=<list>    : Keep only the shapes of the list, e.g. 32-126,U+00B0, and"
+		          << std::endl;
+		std::cout << "                     their subshapes." << std::endl;
+		std::cout << "--subset-text=<file> : Keep only the shapes of the characters of the UTF-8"
+		          << std::endl;
+		std::cout << "                     text file and their subshapes." << std::endl;
+		std::cout << "--diff[=geometry]  : Print the added, removed and changed shapes of two fonts,"
+		          << std::endl;
+		std::cout << "                     optionally with bounding box and advance." << std::endl;
+		std::cout << "--graph=<file.dot> : Save the graph of the subshape references." << std::endl;
+		std::cout << "--metrics=<file>   : Save bounding box and advance of each shape." << std::endl;
+		std::cout << "--header=<file.h>  : Save the compiled font as C++ header." << std::endl;
+		std::cout << "--preview[=]<file> : Save all shapes as image (.pgm or .ppm)." << std::endl;
+		std::cout << "--preview-hashes[=]<file> : Save a hash of the image, the bounding box and"
+		          << std::endl;
+		std::cout << "                     the advance of each shape." << std::endl;
+		std::cout << "--stats   : Print times of the phases, sizes and memory usage." << std::endl;
+		std::cout << "--trace=<file.json> : Save a timeline in the Chrome trace format." << std::endl;
+		std::cout << "--serve   : Compile server on stdin/stdout." << std::endl;
+		std::cout << "--listen <socket>  : Compile server on a UNIX domain socket." << std::endl;
+		std::cout << "--connect <socket> : Compile the files with the server." << std::endl;
 		std::cout << std::endl;
 		std::cout << "For further help contact jameo.de" << std::endl;
 		std::cout << std::endl;
@@ -793,57 +1106,51 @@ int main(int argc, const char* argv[])
 		return 1;
 	};
 
-	// Determine the name of the output file
-	if(outputname.size() < 1)
-	{
-		outputname = inputname;
+	shpc::Trace timeline;
+	if(tracename.size() > 0)trace = &timeline;
 
-		if(outputname.toLowerCase().endsWith(".shp"))
-			outputname = outputname.substring(0, outputname.size() - 4);
-
-		outputname.append(".shx");
-	}
-
-	if(verbose)
+	int result = 0;
+	if(serverMode || listenMode)result = runServer();
+	else if(inputnames.size() == 0)
 	{
-		std::cout << inf << "input file: " << inputname << std::endl;
-		std::cout << inf << "output file: " << outputname << std::endl;
+		std::cout << err << "No input file." << std::endl;
 	}
-
-	if(inputname.size() > 1)
+	else
 	{
-
-		file = new jm::File(inputname);
-		endOfFile = false;
-
-		if(file->exists() == false)
+		// Several inputs, directories and response files are compiled in batch mode
+		const jm::String& first = inputnames[0];
+		if(inputnames.size() > 1 || first.startsWith("@") || jm::File(first).isDirectory())
+			batchMode = true;
+
+		if(decompile)result = decompileFiles();
+		else if(merge)result = mergeFiles();
+		else if(diff)result = diffFiles();
+		else if(subsetlist.size() > 0 || subsettext.size() > 0)result = subsetFile();
+		else if(watchMode && batchMode)
 		{
-			std::cout << err << "Input file \"" << inputname << "\" does not exist" << std::endl;
-			clean();
-			jm::System::quit();
-			return -1;
+			std::cout << err << "Only a single file can be watched." << std::endl;
+			result = -1;
 		}
+		else if(batchMode && !checkBatchOptions())result = usageError;
+		else if(connectMode)result = compileRemote();
+		else if(watchMode)result = watchFile(first);
+		else if(batchMode)result = compileBatch();
+		else result = compileFile(first);
+	}
 
+	if(trace != nullptr)
+	{
 		try
 		{
-			file->open(jm::FileMode::kRead);
-			compile();
-			clean();
-			std::cout << "Done." << std::endl;
+			trace->save(tracename);
 		}
 		catch(jm::Exception& e)
 		{
 			std::cout << err << e.errorMessage() << std::endl;
-			clean();
-			jm::System::quit();
-			return -1;
+			result = -1;
 		}
 	}
-	else
-	{
-		std::cout << err << "No input file." << std::endl;
-	}
+
 	jm::System::quit();
-	return 0;
+	return result;
 }
-
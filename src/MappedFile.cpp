@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        MappedFile.cpp
+// Application: Shape File Compiler
+// Purpose:     Read only view on a file
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+
+using namespace shpc;
+
+MappedFile::MappedFile()
+{
+	mData = nullptr;
+	mSize = 0;
+	mMapped = false;
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+#ifndef _WIN32
+
+void MappedFile::open(const jm::String &filename)
+{
+	close();
+
+	jm::ByteArray path = filename.toCString();
+	int handle = ::open(path.constData(), O_RDONLY | O_CLOEXEC);
+	if(handle < 0)throw jm::Exception("Cannot open file: " + filename);
+
+	struct stat status;
+	if(fstat(handle, &status) != 0)
+	{
+		::close(handle);
+		throw jm::Exception("Cannot open file: " + filename);
+	}
+
+	// An empty file cannot be mapped.
+	if(status.st_size > 0)
+	{
+		void* data = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, handle, 0);
+		if(data == MAP_FAILED)
+		{
+			::close(handle);
+			throw jm::Exception("Cannot map file: " + filename);
+		}
+		mData = (const uint8*)data;
+		mSize = (size_t)status.st_size;
+		mMapped = true;
+	}
+
+	// The mapping stays valid after the file is closed.
+	::close(handle);
+}
+
+void MappedFile::close()
+{
+	if(mMapped)munmap((void*)mData, mSize);
+	mBuffer.clear();
+	mData = nullptr;
+	mSize = 0;
+	mMapped = false;
+}
+
+#else
+
+void MappedFile::open(const jm::String &filename)
+{
+	close();
+
+	jm::File file(filename);
+	if(!file.exists())throw jm::Exception("Cannot open file: " + filename);
+
+	file.open(jm::FileMode::kRead);
+	mBuffer.resize((size_t)file.size());
+	int64 count = mBuffer.empty() ? 0 : file.read(mBuffer.data(), mBuffer.size());
+	file.close();
+
+	if(count != (int64)mBuffer.size())throw jm::Exception("Cannot read file: " + filename);
+
+	mData = mBuffer.empty() ? nullptr : mBuffer.data();
+	mSize = mBuffer.size();
+}
+
+void MappedFile::close()
+{
+	mBuffer.clear();
+	mData = nullptr;
+	mSize = 0;
+	mMapped = false;
+}
+
+#endif
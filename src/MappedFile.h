@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        MappedFile.h
+// Application: Shape File Compiler
+// Purpose:     Read only view on a file
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_MappedFile_h
+#define shpc_MappedFile_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief Read only view on the content of a file. On POSIX systems the file is mapped into
+	 memory, so that only the pages which are used are read. On other systems the file is read
+	 completely into a buffer.
+	 */
+	class MappedFile
+	{
+		public:
+
+			MappedFile();
+
+			~MappedFile();
+
+			/*!
+			 \brief Maps the file. A file mapped before is released.
+			 \throws jm::Exception, if the file cannot be opened.
+			 */
+			void open(const jm::String &filename);
+
+			/*!
+			 \brief Releases the file. The data is no longer valid afterwards.
+			 */
+			void close();
+
+			/*!
+			 \brief Returns the content of the file or nullptr, if it is empty.
+			 */
+			const uint8* data() const
+			{
+				return mData;
+			}
+
+			/*!
+			 \brief Returns the number of bytes of the file.
+			 */
+			size_t size() const
+			{
+				return mSize;
+			}
+
+		private:
+
+			// The content of the file.
+			const uint8* mData;
+
+			// The number of bytes of the file.
+			size_t mSize;
+
+			// Status whether the data is mapped, otherwise it is in the buffer.
+			bool mMapped;
+
+			// The content of the file, if it is not mapped.
+			std::vector<uint8> mBuffer;
+	};
+
+}
+
+#endif
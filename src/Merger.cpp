@@ -0,0 +1,287 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Merger.cpp
+// Application: Shape File Compiler
+// Purpose:     Merging of several fonts
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <queue>
+
+#include "Merger.h"
+
+using namespace shpc;
+
+Merger::Merger()
+{
+	mVerbose = false;
+	mPool = nullptr;
+	mPriority = MergePriority::kFirst;
+	mIsUnicode = false;
+	mIsBigfont = false;
+	mReplaced = 0;
+}
+
+void Merger::setVerbose(bool verbose)
+{
+	mVerbose = verbose;
+}
+
+void Merger::setThreadPool(ThreadPool* pool)
+{
+	mPool = pool;
+}
+
+void Merger::setPriority(MergePriority priority)
+{
+	mPriority = priority;
+}
+
+void Merger::add(const jm::String &filename)
+{
+	mInputs.push_back(filename);
+}
+
+bool Merger::run()
+{
+	try
+	{
+		process();
+	}
+	catch(jm::Exception &e)
+	{
+		report(Severity::kError, e.errorMessage());
+		mImage.allocate(0);
+		return false;
+	}
+	return true;
+}
+
+const ShxImage& Merger::image() const
+{
+	return mImage;
+}
+
+const ShapeTable& Merger::shapes() const
+{
+	return mShapes;
+}
+
+bool Merger::isUnicode() const
+{
+	return mIsUnicode;
+}
+
+uint32 Merger::replaced() const
+{
+	return mReplaced;
+}
+
+const std::vector<Diagnostic>& Merger::diagnostics() const
+{
+	return mDiagnostics;
+}
+
+/*!
+ \brief Releases the inputs of a previous run.
+ */
+void Merger::clear()
+{
+	mSources.clear();
+	mShapes.clear();
+	mLeadBytes.assign(256, 0);
+	mEscapes.clear();
+	mReplaced = 0;
+	mDiagnostics.clear();
+}
+
+void Merger::report(Severity severity, const jm::String &message)
+{
+	mDiagnostics.push_back(Diagnostic(severity, 0, message));
+}
+
+/*!
+ \brief This method controls the merging as a whole.
+ */
+void Merger::process()
+{
+	clear();
+	if(mInputs.size() == 0)throw jm::Exception("No input file.");
+
+	mSources.resize(mInputs.size());
+	for(uint32 a = 0; a < mInputs.size(); a++)read(a);
+
+	merge();
+
+	if(mShapes.size() == 0)throw jm::Exception("No shapes found.");
+	if(mShapes.size() > 0xFFFF)throw jm::Exception("Too many shapes.");
+
+	// The references are resolved in the merged font, because they may refer to other inputs.
+	mGraph.build(mShapes, mIsUnicode || mIsBigfont);
+	mGraph.analyze(mShapes);
+
+	ShxFormat format;
+	if(mIsBigfont)format = ShxFormat::kBigfont;
+	else if(mIsUnicode)format = ShxFormat::kUnifont;
+	else if(mShapes.number(0) == 0)format = ShxFormat::kShapes11;
+	else format = ShxFormat::kShapes10;
+
+	// The lead bytes of all inputs form the escape ranges.
+	for(uint32 a = 0; a < mLeadBytes.size(); a++)
+	{
+		if(mLeadBytes[a] == 0)continue;
+		if(mEscapes.empty() || (uint32)mEscapes.back().last + 1 != a)
+		{
+			EscapeRange range;
+			range.first = (uint8)a;
+			range.last = (uint8)a;
+			mEscapes.push_back(range);
+		}
+		else mEscapes.back().last = (uint8)a;
+	}
+
+	mImage.build(format, mShapes, mEscapes);
+
+	report(Severity::kInfo, jm::String::valueOf((int64)mShapes.size())
+	       + " Shapes merged from "
+	       + jm::String::valueOf((int64)mInputs.size())
+	       + " files, "
+	       + jm::String::valueOf((int64)mReplaced)
+	       + " replaced.");
+}
+
+/*!
+ \brief Reads the shapes of the input. SHX files are used as they are, SHP files are compiled.
+ */
+void Merger::read(uint32 input)
+{
+	const jm::String &filename = mInputs[input];
+	FontFile &font = mSources[input];
+	font.setVerbose(mVerbose);
+	font.setThreadPool(mPool);
+
+	// The references may refer to shapes of other inputs.
+	font.setResolveReferences(false);
+
+	bool success = font.load(filename);
+	const std::vector<Diagnostic> &diagnostics = font.diagnostics();
+	mDiagnostics.insert(mDiagnostics.end(), diagnostics.begin(), diagnostics.end());
+	if(!success)throw jm::Exception("Cannot read \"" + filename + "\".");
+
+	ShxFormat format = font.format();
+	if(format == ShxFormat::kBigfont)addEscapeRanges(font.escapeRanges());
+
+	bool unicode = format == ShxFormat::kUnifont;
+	bool bigfont = format == ShxFormat::kBigfont;
+	if(input == 0)
+	{
+		mIsUnicode = unicode;
+		mIsBigfont = bigfont;
+	}
+	else if(unicode != mIsUnicode || bigfont != mIsBigfont)
+		throw jm::Exception("Cannot merge fonts of different file types: \"" + filename + "\".");
+}
+
+/*!
+ \brief Marks the lead bytes of the escape ranges of a bigfont input.
+ */
+void Merger::addEscapeRanges(const std::vector<EscapeRange> &ranges)
+{
+	for(size_t a = 0; a < ranges.size(); a++)
+	{
+		for(uint32 b = ranges[a].first; b <= ranges[a].last; b++)mLeadBytes[b] = 1;
+	}
+}
+
+/*!
+ \brief Merges the shapes of all inputs by number. A heap holds the next shape of each input, so
+ that the shape with the lowest number is taken in each step. Shapes with the same number come
+ from the heap in the order of the inputs.
+ */
+void Merger::merge()
+{
+	struct Head
+	{
+		uint16 number;
+		uint32 input;
+		uint32 position;
+	};
+
+	auto later = [](const Head &a, const Head &b)
+	{
+		return a.number > b.number || (a.number == b.number && a.input > b.input);
+	};
+	std::priority_queue<Head, std::vector<Head>, decltype(later)> heap(later);
+
+	uint32 arena = 0;
+	for(uint32 a = 0; a < mSources.size(); a++)
+	{
+		const ShapeTable &shapes = mSources[a].shapes();
+		arena += shapes.arenaSize();
+		if(shapes.size() > 0)heap.push({shapes.number(0), a, 0});
+	}
+	mShapes.reserve(arena);
+
+	while(!heap.empty())
+	{
+		Head head = heap.top();
+		heap.pop();
+
+		// The shapes with the same number of the other inputs follow directly.
+		Head winner = head;
+		while(true)
+		{
+			const ShapeTable &shapes = mSources[head.input].shapes();
+			if(head.position + 1 < shapes.size())
+				heap.push({shapes.number(head.position + 1), head.input, head.position + 1});
+
+			if(heap.empty() || heap.top().number != winner.number)break;
+			head = heap.top();
+			heap.pop();
+
+			Head loser = head;
+			if(mPriority == MergePriority::kLast)std::swap(winner, loser);
+			mReplaced++;
+
+			if(mVerbose)
+				report(Severity::kInfo, "Shape "
+				       + jm::String::valueOf((int64)head.number)
+				       + " of \"" + mInputs[loser.input]
+				       + "\" replaced by \"" + mInputs[winner.input] + "\".");
+		}
+
+		const ShapeTable &shapes = mSources[winner.input].shapes();
+		uint32 position = winner.position;
+		uint16 defBytes = shapes.defBytes(position);
+		uint32 index = mShapes.add(shapes.number(position),
+		                           defBytes,
+		                           shapes.encodedName(position),
+		                           shapes.nameLength(position));
+		const uint8* bytes = shapes.buffer(position);
+		for(uint16 a = 0; a < defBytes; a++)mShapes.append(index, bytes[a]);
+	}
+}
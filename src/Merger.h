@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Merger.h
+// Application: Shape File Compiler
+// Purpose:     Merging of several fonts
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_Merger_h
+#define shpc_Merger_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+#include "Compiler.h"
+#include "FontFile.h"
+#include "ShapeGraph.h"
+#include "ShapeTable.h"
+#include "ShxImage.h"
+#include "ThreadPool.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief Determines, which input wins, if several inputs have a shape with the same number.
+	 */
+	enum class MergePriority
+	{
+		// The shape of the input added first is taken.
+		kFirst,
+
+		// The shape of the input added last is taken.
+		kLast
+	};
+
+	/*!
+	 \brief The merger combines the shapes of several fonts into one SHX file, e.g. a Unicode font
+	 from separate sources for Latin, Greek and symbols. The inputs may be SHP files, which are
+	 compiled, or SHX files, whose shapes are taken as they are without compiling them again.
+
+	 The shapes of all inputs are merged by their number in one pass over the inputs (k-way merge),
+	 so the inputs may cover overlapping ranges of numbers. All inputs must be either Unicode fonts,
+	 bigfonts or normal fonts. The subshape references are resolved in the merged font. The escape
+	 ranges of merged bigfonts cover the lead bytes of all inputs.
+	 */
+	class Merger
+	{
+		public:
+
+			Merger();
+
+			/*!
+			 \brief Status whether detailed information is added to the diagnostics.
+			 */
+			void setVerbose(bool verbose);
+
+			/*!
+			 \brief Sets the thread pool, on which large SHP files are compiled. If nullptr
+			 (default), all files are compiled in the calling thread.
+			 */
+			void setThreadPool(ThreadPool* pool);
+
+			/*!
+			 \brief Sets, which input wins for shapes with the same number. Default: kFirst.
+			 */
+			void setPriority(MergePriority priority);
+
+			/*!
+			 \brief Adds an input. Files with the extension ".shx" are read as SHX files, all others
+			 are compiled as SHP files.
+			 */
+			void add(const jm::String &filename);
+
+			/*!
+			 \brief Reads all inputs, merges their shapes and writes the SHX image.
+			 \return true on success. On failure the diagnostics contain at least one error.
+			 */
+			bool run();
+
+			/*!
+			 \brief Returns the merged SHX file. Only valid after successful merging.
+			 */
+			const ShxImage& image() const;
+
+			/*!
+			 \brief Returns the merged shapes.
+			 */
+			const ShapeTable& shapes() const;
+
+			/*!
+			 \brief Returns true, if the merged font is in Unicode format.
+			 */
+			bool isUnicode() const;
+
+			/*!
+			 \brief Returns the number of shapes, which were dropped, because an input with higher
+			 priority has a shape with the same number.
+			 */
+			uint32 replaced() const;
+
+			/*!
+			 \brief Returns all messages of the merging. Messages of the compilation of an input
+			 start with the name of the input.
+			 */
+			const std::vector<Diagnostic>& diagnostics() const;
+
+		private:
+
+			// Status whether detailed information is reported.
+			bool mVerbose;
+
+			// The pool for the compilation or nullptr.
+			ThreadPool* mPool;
+
+			// The priority of the inputs.
+			MergePriority mPriority;
+
+			// The names of the inputs.
+			std::vector<jm::String> mInputs;
+
+			// The inputs with their shapes ordered by number.
+			std::vector<FontFile> mSources;
+
+			// Status whether the fonts are Unicode fonts.
+			bool mIsUnicode;
+
+			// Status whether the fonts are bigfonts.
+			bool mIsBigfont;
+
+			// For each byte, whether it is a lead byte of an escape range of a bigfont input.
+			std::vector<uint8> mLeadBytes;
+
+			// The escape ranges of the merged bigfont.
+			std::vector<EscapeRange> mEscapes;
+
+			// The merged shapes.
+			ShapeTable mShapes;
+
+			// The subshape references of the merged shapes.
+			ShapeGraph mGraph;
+
+			// The merged SHX file.
+			ShxImage mImage;
+
+			// The number of dropped shapes.
+			uint32 mReplaced;
+
+			// The messages.
+			std::vector<Diagnostic> mDiagnostics;
+
+			void process();
+
+			void read(uint32 input);
+
+			void addEscapeRanges(const std::vector<EscapeRange> &ranges);
+
+			void merge();
+
+			void clear();
+
+			void report(Severity severity, const jm::String &message);
+	};
+
+}
+
+#endif
@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        MetricsFile.cpp
+// Application: Shape File Compiler
+// Purpose:     Metrics sidecar file
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+
+#include "AtomicFile.h"
+#include "Interpreter.h"
+#include "MappedFile.h"
+#include "MetricsFile.h"
+
+using namespace shpc;
+
+/*!
+ \brief The first bytes of a metrics file. The number changes with the format.
+ */
+static const char* kMagic = "shpc-metrics 1\x1A";
+
+static const uint32 kMagicLength = 15;
+
+// The number of bytes of an entry.
+static const uint32 kEntrySize = 32;
+
+static uint32 readLE32(const uint8* data)
+{
+	return (uint32)data[0]
+	       | ((uint32)data[1] << 8)
+	       | ((uint32)data[2] << 16)
+	       | ((uint32)data[3] << 24);
+}
+
+static float readFloat(const uint8* data)
+{
+	uint32 bits = readLE32(data);
+	float value;
+	std::memcpy(&value, &bits, 4);
+	return value;
+}
+
+static void writeLE32(std::vector<uint8> &data, uint32 value)
+{
+	for(uint32 a = 0; a < 4; a++)data.push_back((uint8)(value >> (8 * a)));
+}
+
+static void writeFloat(std::vector<uint8> &data, float value)
+{
+	uint32 bits;
+	std::memcpy(&bits, &value, 4);
+	writeLE32(data, bits);
+}
+
+MetricsFile::MetricsFile()
+{
+}
+
+void MetricsFile::build(const ShapeTable &shapes, bool unicode)
+{
+	mMetrics.clear();
+	mMetrics.reserve(shapes.size());
+
+	Interpreter interpreter(shapes, unicode);
+	Outline outline;
+
+	for(uint32 a = 0; a < shapes.size(); a++)
+	{
+		if(shapes.number(a) == 0)continue;
+
+		interpreter.run(a, outline);
+
+		GlyphMetrics metrics;
+		metrics.number = shapes.number(a);
+		metrics.minimum = outline.minimum();
+		metrics.maximum = outline.maximum();
+		metrics.advance = outline.advance();
+		metrics.segments = outline.segments();
+		mMetrics.push_back(metrics);
+	}
+
+	std::sort(mMetrics.begin(), mMetrics.end(), [](const GlyphMetrics &a, const GlyphMetrics &b)
+	{
+		return a.number < b.number;
+	});
+}
+
+void MetricsFile::load(const jm::String &filename)
+{
+	mMetrics.clear();
+
+	MappedFile file;
+	file.open(filename);
+
+	const uint8* data = file.data();
+	size_t size = file.size();
+	if(size < kMagicLength + 4 || std::memcmp(data, kMagic, kMagicLength) != 0)
+		throw jm::Exception("Invalid metrics file: " + filename);
+
+	uint32 count = readLE32(data + kMagicLength);
+	if(size != kMagicLength + 4 + (size_t)count * kEntrySize)
+		throw jm::Exception("Invalid metrics file: " + filename);
+
+	mMetrics.resize(count);
+	const uint8* entry = data + kMagicLength + 4;
+	for(uint32 a = 0; a < count; a++, entry += kEntrySize)
+	{
+		GlyphMetrics &metrics = mMetrics[a];
+		metrics.number = (uint16)(entry[0] | (entry[1] << 8));
+		metrics.minimum = {readFloat(entry + 4), readFloat(entry + 8)};
+		metrics.maximum = {readFloat(entry + 12), readFloat(entry + 16)};
+		metrics.advance = {readFloat(entry + 20), readFloat(entry + 24)};
+		metrics.segments = readLE32(entry + 28);
+	}
+}
+
+void MetricsFile::save(const jm::String &filename) const
+{
+	std::vector<uint8> data(kMagic, kMagic + kMagicLength);
+	data.reserve(kMagicLength + 4 + mMetrics.size() * kEntrySize);
+	writeLE32(data, (uint32)mMetrics.size());
+
+	for(size_t a = 0; a < mMetrics.size(); a++)
+	{
+		const GlyphMetrics &metrics = mMetrics[a];
+		data.push_back((uint8)metrics.number);
+		data.push_back((uint8)(metrics.number >> 8));
+		data.push_back(0);
+		data.push_back(0);
+		writeFloat(data, metrics.minimum.x);
+		writeFloat(data, metrics.minimum.y);
+		writeFloat(data, metrics.maximum.x);
+		writeFloat(data, metrics.maximum.y);
+		writeFloat(data, metrics.advance.x);
+		writeFloat(data, metrics.advance.y);
+		writeLE32(data, metrics.segments);
+	}
+
+	saveAtomic(filename, data.data(), data.size());
+}
+
+uint32 MetricsFile::size() const
+{
+	return (uint32)mMetrics.size();
+}
+
+const GlyphMetrics& MetricsFile::metrics(uint32 index) const
+{
+	return mMetrics[index];
+}
+
+const GlyphMetrics* MetricsFile::find(uint16 number) const
+{
+	std::vector<GlyphMetrics>::const_iterator it;
+	it = std::lower_bound(mMetrics.begin(),
+	                      mMetrics.end(),
+	                      number,
+	                      [](const GlyphMetrics &metrics, uint16 value)
+	{
+		return metrics.number < value;
+	});
+
+	if(it == mMetrics.end() || it->number != number)return nullptr;
+	return &*it;
+}
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        MetricsFile.h
+// Application: Shape File Compiler
+// Purpose:     Metrics sidecar file
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_MetricsFile_h
+#define shpc_MetricsFile_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+#include "Outline.h"
+#include "ShapeTable.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The metrics of a shape for text layout.
+	 */
+	struct GlyphMetrics
+	{
+		// The shape number.
+		uint16 number;
+
+		// The bounding box of the outline.
+		Point minimum;
+		Point maximum;
+
+		// The position of the pen after the shape.
+		Point advance;
+
+		// The number of line segments of the outline.
+		uint32 segments;
+	};
+
+	/*!
+	 \brief The metrics sidecar file holds the metrics of all shapes of a font, so that a layout
+	 engine does not need to interpret the shapes. The file starts with a magic string and the
+	 number of entries (32-bit). Each entry has 32 bytes: the shape number (16-bit), 2 reserved
+	 bytes, the bounding box, the advance (each as 32-bit floats) and the number of segments
+	 (32-bit). All values are little endian and the entries are ordered by the shape number.
+	 */
+	class MetricsFile
+	{
+		public:
+
+			MetricsFile();
+
+			/*!
+			 \brief Determines the metrics of all shapes except shape 0 by interpreting them in
+			 horizontal mode. The spec bytes must be valid.
+			 \throws jm::Exception, if a subshape does not exist.
+			 */
+			void build(const ShapeTable &shapes, bool unicode);
+
+			/*!
+			 \brief Loads the metrics file.
+			 \throws jm::Exception, if the file cannot be read or is no metrics file.
+			 */
+			void load(const jm::String &filename);
+
+			/*!
+			 \brief Saves the metrics file. The data is first written to a temporary file next to the
+			 target, which is then renamed.
+			 */
+			void save(const jm::String &filename) const;
+
+			/*!
+			 \brief Returns the number of entries.
+			 */
+			uint32 size() const;
+
+			/*!
+			 \brief Returns the entry at the index.
+			 */
+			const GlyphMetrics& metrics(uint32 index) const;
+
+			/*!
+			 \brief Returns the metrics of the shape with the number or nullptr.
+			 */
+			const GlyphMetrics* find(uint16 number) const;
+
+		private:
+
+			// The entries ordered by the shape number.
+			std::vector<GlyphMetrics> mMetrics;
+	};
+
+}
+
+#endif
@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Optimizer.cpp
+// Application: Shape File Compiler
+// Purpose:     Peephole optimizer for spec bytes
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Optimizer.h"
+#include "SpecValidator.h"
+
+using namespace shpc;
+
+/*!
+ \brief The end points of the vectors of length 1 of the 16 directions in half units. The vectors of
+ the odd directions end on the square around the start, e.g. direction 1 at (1, 0.5).
+ */
+static const int32 kDirections[16][2] =
+{
+	{2, 0}, {2, 1}, {2, 2}, {1, 2}, {0, 2}, {-1, 2}, {-2, 2}, {-2, 1},
+	{-2, 0}, {-2, -1}, {-2, -2}, {-1, -2}, {0, -2}, {1, -2}, {2, -2}, {2, -1}
+};
+
+/*!
+ \brief Returns the vector byte for the displacement or 0, if the displacement is no vector.
+ */
+static uint8 toVector(int32 dx, int32 dy)
+{
+	for(int32 direction = 0; direction < 16; direction++)
+	{
+		int32 u = kDirections[direction][0];
+		int32 v = kDirections[direction][1];
+		int32 length = (u != 0) ? 2 * dx / u : 2 * dy / v;
+
+		if(length < 1 || length > 15)continue;
+		if(length * u == 2 * dx && length * v == 2 * dy)return (uint8)((length << 4) | direction);
+	}
+	return 0;
+}
+
+template<bool kUnicode>
+uint32 Optimizer<kUnicode>::optimize(std::vector<uint8> &bytes)
+{
+	uint32 before = (uint32)bytes.size();
+
+	std::vector<uint8> out;
+	while(pass(bytes, out))bytes.swap(out);
+
+	return before - (uint32)bytes.size();
+}
+
+/*!
+ \brief Copies the commands and applies the rules once.
+ \return true, if something was changed.
+ */
+template<bool kUnicode>
+bool Optimizer<kUnicode>::pass(const std::vector<uint8> &in, std::vector<uint8> &out)
+{
+	out.clear();
+
+	// The start of each command in the output and the status, whether it is executed only in
+	// vertical mode.
+	std::vector<uint32> starts;
+	std::vector<bool> conditional;
+
+	// The pen state: 0 = unknown, 1 = down, 2 = up
+	uint8 pen = 0;
+
+	bool afterDoNext = false;
+	bool changed = false;
+
+	uint32 position = 0;
+	while(position < in.size())
+	{
+		const uint8* command = in.data() + position;
+		uint32 size = commandSize<kUnicode>(in.data(), position);
+		position += size;
+
+		bool changeable = !afterDoNext;
+		afterDoNext = command[0] == 14;
+
+		// The last command in the output, which may be changed, or 0.
+		uint8 last = 0;
+		if(starts.size() > 0 && !conditional.back())last = out[starts.back()];
+
+		uint8 code = command[0];
+		if(changeable && code == 8)
+		{
+			uint8 vector = toVector((int8)command[1], (int8)command[2]);
+			if(vector != 0)
+			{
+				code = vector;
+				changed = true;
+			}
+		}
+
+		if(changeable && code > 0x0F)
+		{
+			// Merge vectors of the same direction
+			if(last > 0x0F && (last & 0x0F) == (code & 0x0F) && (last >> 4) + (code >> 4) <= 15)
+			{
+				out[starts.back()] = (uint8)(last + (code & 0xF0));
+				changed = true;
+				continue;
+			}
+
+			starts.push_back((uint32)out.size());
+			conditional.push_back(false);
+			out.push_back(code);
+			continue;
+		}
+
+		if(changeable && (code == 1 || code == 2))
+		{
+			if(pen == code)
+			{
+				changed = true;
+				continue;
+			}
+			pen = code;
+
+			// Without movement, the previous pen command has no effect.
+			if(last == 1 || last == 2)
+			{
+				out[starts.back()] = code;
+				changed = true;
+				continue;
+			}
+		}
+
+		if(changeable && code == 6 && last == 5)
+		{
+			out.resize(starts.back());
+			starts.pop_back();
+			conditional.pop_back();
+			changed = true;
+			continue;
+		}
+
+		if(code == 7 || (!changeable && (code == 1 || code == 2)))pen = 0;
+
+		starts.push_back((uint32)out.size());
+		conditional.push_back(!changeable);
+		out.insert(out.end(), command, command + size);
+	}
+
+	return changed;
+}
+
+template class shpc::Optimizer<false>;
+template class shpc::Optimizer<true>;
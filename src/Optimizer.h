@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Optimizer.h
+// Application: Shape File Compiler
+// Purpose:     Peephole optimizer for spec bytes
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_Optimizer_h
+#define shpc_Optimizer_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief Peephole optimizer for the spec bytes of a shape. The rendering of the shape stays the
+	 same. The optimizer works on whole commands and repeats until nothing changes:
+	 - A Line-To-Command (8), whose displacement is a vector of one of the 16 directions, is replaced
+	   by the vector byte.
+	 - Consecutive vectors of the same direction are merged, as long as the length fits.
+	 - A Pen-Down-Command (1) or Pen-Up-Command (2), which sets the current state again or is
+	   directly followed by another pen command, is removed.
+	 - A Push-Command (5) directly followed by a Pop-Command (6) is removed.
+	 A command after a Do-Next-Command (14) is never changed, because it is only executed in
+	 vertical mode. The pen state is unknown at the start of a shape and after a subshape, because a
+	 shape may be used as subshape.
+	 */
+	template<bool kUnicode>
+	class Optimizer
+	{
+		public:
+
+			/*!
+			 \brief Optimizes the spec bytes of a shape. The spec bytes must be valid.
+			 \return The number of bytes saved.
+			 */
+			static uint32 optimize(std::vector<uint8> &bytes);
+
+		private:
+
+			static bool pass(const std::vector<uint8> &in, std::vector<uint8> &out);
+	};
+
+}
+
+#endif
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Outline.cpp
+// Application: Shape File Compiler
+// Purpose:     Polylines of a shape
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Outline.h"
+#include "Transform.h"
+
+using namespace shpc;
+
+Outline::Outline()
+{
+	clear();
+}
+
+void Outline::clear()
+{
+	mPoints.clear();
+	mFirst.clear();
+	mMinimum = {0, 0};
+	mMaximum = {0, 0};
+	mAdvance = {0, 0};
+}
+
+void Outline::moveTo(float x, float y)
+{
+	mFirst.push_back(size());
+	mPoints.push_back({x, y});
+	extend(size() - 1);
+}
+
+void Outline::lineTo(float x, float y)
+{
+	mPoints.push_back({x, y});
+	extend(size() - 1);
+}
+
+void Outline::append(const Outline &other, const Transform &transform)
+{
+	uint32 offset = size();
+	for(uint32 a = 0; a < other.polylines(); a++)mFirst.push_back(offset + other.first(a));
+
+	mPoints.resize(offset + other.size());
+	transform.apply(other.points(), mPoints.data() + offset, other.size());
+	extend(offset);
+}
+
+void Outline::setAdvance(float x, float y)
+{
+	mAdvance = {x, y};
+}
+
+/*!
+ \brief Extends the bounding box by the points from the index on.
+ */
+void Outline::extend(uint32 begin)
+{
+	if(begin >= size())return;
+	if(begin == 0)
+	{
+		mMinimum = mPoints[0];
+		mMaximum = mPoints[0];
+	}
+
+	for(uint32 a = begin; a < size(); a++)
+	{
+		const Point &point = mPoints[a];
+		if(point.x < mMinimum.x)mMinimum.x = point.x;
+		if(point.y < mMinimum.y)mMinimum.y = point.y;
+		if(point.x > mMaximum.x)mMaximum.x = point.x;
+		if(point.y > mMaximum.y)mMaximum.y = point.y;
+	}
+}
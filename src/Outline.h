@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Outline.h
+// Application: Shape File Compiler
+// Purpose:     Polylines of a shape
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_Outline_h
+#define shpc_Outline_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+namespace shpc
+{
+
+	class Transform;
+
+	/*!
+	 \brief A point in the units of the shape, i.e. a vector of length 1 in direction 0 is (1, 0).
+	 */
+	struct Point
+	{
+		float x;
+		float y;
+	};
+
+	/*!
+	 \brief The geometry of a shape as polylines, which are drawn with the pen down. The points of
+	 all polylines are stored in one array, the polylines refer to their first point. The outline
+	 also holds the bounding box of the points and the advance, i.e. the position of the pen after
+	 the shape.
+	 */
+	class Outline
+	{
+		public:
+
+			Outline();
+
+			/*!
+			 \brief Removes all polylines. The allocated memory is kept for reuse.
+			 */
+			void clear();
+
+			/*!
+			 \brief Starts a new polyline at the point.
+			 */
+			void moveTo(float x, float y);
+
+			/*!
+			 \brief Adds a segment from the last point to the point to the current polyline.
+			 */
+			void lineTo(float x, float y);
+
+			/*!
+			 \brief Appends the polylines of the other outline transformed by the transformation.
+			 */
+			void append(const Outline &other, const Transform &transform);
+
+			/*!
+			 \brief Sets the position of the pen after the shape.
+			 */
+			void setAdvance(float x, float y);
+
+			/*!
+			 \brief Returns the number of polylines.
+			 */
+			uint32 polylines() const
+			{
+				return (uint32)mFirst.size();
+			}
+
+			/*!
+			 \brief Returns the index of the first point of the polyline.
+			 */
+			uint32 first(uint32 polyline) const
+			{
+				return mFirst[polyline];
+			}
+
+			/*!
+			 \brief Returns the number of points of the polyline.
+			 */
+			uint32 count(uint32 polyline) const
+			{
+				uint32 end = polyline + 1 < mFirst.size() ? mFirst[polyline + 1] : size();
+				return end - mFirst[polyline];
+			}
+
+			/*!
+			 \brief Returns the number of points of all polylines.
+			 */
+			uint32 size() const
+			{
+				return (uint32)mPoints.size();
+			}
+
+			/*!
+			 \brief Returns the points of all polylines.
+			 */
+			const Point* points() const
+			{
+				return mPoints.data();
+			}
+
+			/*!
+			 \brief Returns the number of line segments of all polylines.
+			 */
+			uint32 segments() const
+			{
+				return size() - polylines();
+			}
+
+			/*!
+			 \brief Returns the lower left corner of the bounding box. (0, 0) if nothing is drawn.
+			 */
+			const Point& minimum() const
+			{
+				return mMinimum;
+			}
+
+			/*!
+			 \brief Returns the upper right corner of the bounding box. (0, 0) if nothing is drawn.
+			 */
+			const Point& maximum() const
+			{
+				return mMaximum;
+			}
+
+			/*!
+			 \brief Returns the position of the pen after the shape.
+			 */
+			const Point& advance() const
+			{
+				return mAdvance;
+			}
+
+		private:
+
+			// The points of all polylines.
+			std::vector<Point> mPoints;
+
+			// The index of the first point of each polyline.
+			std::vector<uint32> mFirst;
+
+			// The bounding box.
+			Point mMinimum;
+			Point mMaximum;
+
+			// The position of the pen after the shape.
+			Point mAdvance;
+
+			void extend(uint32 begin);
+	};
+
+}
+
+#endif
@@ -0,0 +1,453 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Preview.cpp
+// Application: Shape File Compiler
+// Purpose:     Contact sheet of the shapes
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "AtomicFile.h"
+#include "Interpreter.h"
+#include "Preview.h"
+#include "ShapeCache.h"
+
+using namespace shpc;
+
+// The number of tiles rendered by one task.
+static const uint32 kTilesPerTask = 256;
+
+// The free pixels between the grid lines and the shape.
+static const int32 kMargin = 2;
+
+// The values of the pixels of a tile.
+static const uint8 kBackground = 0;
+static const uint8 kInk = 1;
+static const uint8 kStart = 2;
+
+// The gray values and colors of the sheet for the values of the pixels.
+static const uint8 kGrays[3] = {255, 0, 0};
+static const uint8 kColors[3][3] = {{255, 255, 255}, {0, 0, 0}, {255, 0, 0}};
+static const uint8 kGrid = 208;
+
+/*!
+ \brief Sets the pixel, if it is inside of the tile.
+ */
+static inline void plot(std::vector<uint8> &pixels, int32 size, int32 x, int32 y, uint8 value)
+{
+	if(x >= 0 && y >= 0 && x < size && y < size)pixels[y * size + x] = value;
+}
+
+/*!
+ \brief Draws a line with the Bresenham algorithm, i.e. one pixel per step along the longer axis.
+ */
+static void drawLine(std::vector<uint8> &pixels, int32 size, int32 x0, int32 y0, int32 x1, int32 y1)
+{
+	int32 dx = std::abs(x1 - x0);
+	int32 dy = -std::abs(y1 - y0);
+	int32 sx = x0 < x1 ? 1 : -1;
+	int32 sy = y0 < y1 ? 1 : -1;
+	int32 error = dx + dy;
+
+	while(true)
+	{
+		plot(pixels, size, x0, y0, kInk);
+		if(x0 == x1 && y0 == y1)break;
+
+		int32 e2 = 2 * error;
+		if(e2 >= dy)
+		{
+			error += dy;
+			x0 += sx;
+		}
+		if(e2 <= dx)
+		{
+			error += dx;
+			y0 += sy;
+		}
+	}
+}
+
+/*!
+ \brief Clips the line to the square from low to high on both axes (Liang-Barsky). Shapes may lie
+ far outside of the frame of the font, so their lines are clipped before they are rasterized.
+ \return false, if the line is completely outside.
+ */
+static bool clipLine(float &x0, float &y0, float &x1, float &y1, float low, float high)
+{
+	float dx = x1 - x0;
+	float dy = y1 - y0;
+	float p[4] = {-dx, dx, -dy, dy};
+	float q[4] = {x0 - low, high - x0, y0 - low, high - y0};
+	float t0 = 0;
+	float t1 = 1;
+
+	for(uint32 a = 0; a < 4; a++)
+	{
+		if(p[a] == 0)
+		{
+			if(q[a] < 0)return false;
+			continue;
+		}
+		float t = q[a] / p[a];
+		if(p[a] < 0)t0 = std::max(t0, t);
+		else t1 = std::min(t1, t);
+	}
+	if(t0 > t1)return false;
+
+	x1 = x0 + t1 * dx;
+	y1 = y0 + t1 * dy;
+	x0 = x0 + t0 * dx;
+	y0 = y0 + t0 * dy;
+	return true;
+}
+
+const uint32 Preview::kTileSize;
+
+Preview::Preview()
+{
+	mTileSize = kTileSize;
+	mColor = false;
+	mPool = nullptr;
+	mColumns = 0;
+	mWidth = 0;
+	mHeight = 0;
+	mMinimum = {0, 0};
+	mScale = 1;
+}
+
+void Preview::setTileSize(uint32 size)
+{
+	mTileSize = std::max(size, (uint32)8);
+}
+
+void Preview::setColor(bool color)
+{
+	mColor = color;
+}
+
+void Preview::setThreadPool(ThreadPool* pool)
+{
+	mPool = pool;
+}
+
+void Preview::render(const ShapeTable &shapes, bool unicode)
+{
+	std::vector<uint32> order;
+	for(uint32 a = 0; a < shapes.size(); a++)
+	{
+		if(shapes.number(a) != 0)order.push_back(a);
+	}
+	std::sort(order.begin(), order.end(), [&shapes](uint32 a, uint32 b)
+	{
+		return shapes.number(a) < shapes.number(b);
+	});
+
+	uint32 count = (uint32)order.size();
+	mColumns = std::max((uint32)std::ceil(std::sqrt((double)count)), (uint32)1);
+	mWidth = mColumns * mTileSize;
+	mHeight = (count + mColumns - 1) / mColumns * mTileSize;
+	mPixels.assign((size_t)mWidth * mHeight * (mColor ? 3 : 1), 255);
+	mNumbers.resize(count);
+	mHashes.resize(count);
+
+	// All shapes are drawn in one frame, so that their sizes and positions can be compared.
+	if(!fontFrame(shapes))
+	{
+		// Without font information the frame holds the bounding boxes of all shapes and the
+		// origin.
+		std::vector<Point> minimum(count);
+		std::vector<Point> maximum(count);
+		auto measure = [this, &shapes, unicode, &order, &minimum, &maximum](uint32 begin,
+		                                                                    uint32 end)
+		{
+			measureTiles(shapes, unicode, order, begin, end, minimum, maximum);
+		};
+		forSections(count, measure);
+
+		mMinimum = {0, 0};
+		Point top = {0, 0};
+		for(uint32 a = 0; a < count; a++)
+		{
+			mMinimum.x = std::min(mMinimum.x, minimum[a].x);
+			mMinimum.y = std::min(mMinimum.y, minimum[a].y);
+			top.x = std::max(top.x, maximum[a].x);
+			top.y = std::max(top.y, maximum[a].y);
+		}
+		float extent = std::max(top.x - mMinimum.x, top.y - mMinimum.y);
+		mScale = extent > 0 ? (float)innerSize() / extent : 1;
+	}
+
+	forSections(count, [this, &shapes, unicode, &order](uint32 begin, uint32 end)
+	{
+		renderTiles(shapes, unicode, order, begin, end);
+	});
+}
+
+/*!
+ \brief Returns the size of the area of a tile, in which the shapes are drawn.
+ */
+uint32 Preview::innerSize() const
+{
+	return mTileSize - 2 - 2 * kMargin;
+}
+
+/*!
+ \brief Determines the frame from the font information in shape 0, i.e. the height above and below
+ the baseline (in bigfonts the height and 0). The frame is twice as large as the height, so that
+ wide shapes, accents and descenders fit. It does not depend on the other shapes, so a changed
+ shape changes only its own tile.
+ \return false, if the font has no font information.
+ */
+bool Preview::fontFrame(const ShapeTable &shapes)
+{
+	for(uint32 a = 0; a < shapes.size(); a++)
+	{
+		if(shapes.number(a) != 0 || shapes.defBytes(a) < 2)continue;
+
+		float above = shapes.buffer(a)[0];
+		float below = shapes.buffer(a)[1];
+		float height = above + below;
+		if(height <= 0)return false;
+
+		mMinimum = {-height / 2, -below - height / 2};
+		mScale = (float)innerSize() / (2 * height);
+		return true;
+	}
+	return false;
+}
+
+/*!
+ \brief Calls the task for the sections of the tiles on the thread pool or, without pool or for few
+ tiles, for all tiles in the calling thread. The first error of a section is thrown.
+ */
+void Preview::forSections(uint32 count, const std::function<void(uint32, uint32)> &task)
+{
+	if(mPool == nullptr || count <= kTilesPerTask)
+	{
+		task(0, count);
+		return;
+	}
+
+	struct Section
+	{
+		uint32 begin;
+		uint32 end;
+		bool failed;
+		jm::String error;
+	};
+
+	std::vector<Section> sections;
+	for(uint32 begin = 0; begin < count; begin += kTilesPerTask)
+	{
+		Section section;
+		section.begin = begin;
+		section.end = std::min(begin + kTilesPerTask, count);
+		section.failed = false;
+		sections.push_back(section);
+	}
+
+	TaskGroup group;
+	for(size_t a = 0; a < sections.size(); a++)
+	{
+		Section* section = &sections[a];
+		mPool->submit([section, &task]
+		{
+			try
+			{
+				task(section->begin, section->end);
+			}
+			catch(jm::Exception &e)
+			{
+				section->failed = true;
+				section->error = e.errorMessage();
+			}
+		}, &group);
+	}
+	mPool->wait(group);
+
+	for(size_t a = 0; a < sections.size(); a++)
+	{
+		if(sections[a].failed)throw jm::Exception(sections[a].error);
+	}
+}
+
+/*!
+ \brief Determines the bounding boxes of the shapes of the tiles from begin to end.
+ */
+void Preview::measureTiles(const ShapeTable &shapes,
+                           bool unicode,
+                           const std::vector<uint32> &order,
+                           uint32 begin,
+                           uint32 end,
+                           std::vector<Point> &minimum,
+                           std::vector<Point> &maximum) const
+{
+	Interpreter interpreter(shapes, unicode);
+	Outline outline;
+
+	for(uint32 tile = begin; tile < end; tile++)
+	{
+		interpreter.run(order[tile], outline);
+		minimum[tile] = outline.minimum();
+		maximum[tile] = outline.maximum();
+	}
+}
+
+/*!
+ \brief Renders the tiles from begin to end. Each call has its own interpreter, so that several
+ ranges can be rendered at once.
+ */
+void Preview::renderTiles(const ShapeTable &shapes,
+                          bool unicode,
+                          const std::vector<uint32> &order,
+                          uint32 begin,
+                          uint32 end)
+{
+	Interpreter interpreter(shapes, unicode);
+	Outline outline;
+	std::vector<uint8> pixels;
+
+	for(uint32 tile = begin; tile < end; tile++)
+	{
+		interpreter.run(order[tile], outline);
+		mNumbers[tile] = shapes.number(order[tile]);
+		drawTile(outline, tile, pixels);
+	}
+}
+
+/*!
+ \brief Draws the outline into the tile, determines the hash and copies the tile into the sheet.
+ The last row and column of the tile are the grid lines.
+ */
+void Preview::drawTile(const Outline &outline, uint32 tile, std::vector<uint8> &pixels)
+{
+	int32 size = (int32)mTileSize - 1;
+	pixels.assign(size * size, kBackground);
+
+	// The frame of the font starts at the margin.
+	float left = kMargin - mMinimum.x * mScale;
+	float bottom = kMargin - mMinimum.y * mScale;
+
+	// Rows go from the top to the bottom.
+	const Point* points = outline.points();
+	for(uint32 polyline = 0; polyline < outline.polylines(); polyline++)
+	{
+		uint32 first = outline.first(polyline);
+		uint32 last = first + outline.count(polyline) - 1;
+		for(uint32 a = first; a < last; a++)
+		{
+			float x0 = left + points[a].x * mScale;
+			float y0 = size - 1 - bottom - points[a].y * mScale;
+			float x1 = left + points[a + 1].x * mScale;
+			float y1 = size - 1 - bottom - points[a + 1].y * mScale;
+			if(!clipLine(x0, y0, x1, y1, -1, (float)size))continue;
+
+			drawLine(pixels,
+			         size,
+			         (int32)std::lround(x0),
+			         (int32)std::lround(y0),
+			         (int32)std::lround(x1),
+			         (int32)std::lround(y1));
+		}
+	}
+	float x = left;
+	float y = size - 1 - bottom;
+	if(clipLine(x, y, x, y, -1, (float)size))
+		plot(pixels, size, (int32)std::lround(x), (int32)std::lround(y), kStart);
+
+	// Small changes of the size, the position or the advance may not change a pixel.
+	float geometry[6] = {outline.minimum().x, outline.minimum().y,
+	                     outline.maximum().x, outline.maximum().y,
+	                     outline.advance().x, outline.advance().y};
+	uint64 h = hash(pixels.data(), pixels.size());
+	mHashes[tile] = hash((const uint8*)geometry, sizeof(geometry), h);
+
+	// Copy into the sheet
+	uint32 channels = mColor ? 3 : 1;
+	uint32 x0 = tile % mColumns * mTileSize;
+	uint32 y0 = tile / mColumns * mTileSize;
+	for(uint32 y = 0; y < mTileSize; y++)
+	{
+		uint8* row = mPixels.data() + ((size_t)(y0 + y) * mWidth + x0) * channels;
+		for(uint32 x = 0; x < mTileSize; x++, row += channels)
+		{
+			if(x == (uint32)size || y == (uint32)size)
+			{
+				for(uint32 c = 0; c < channels; c++)row[c] = kGrid;
+				continue;
+			}
+
+			uint8 value = pixels[y * size + x];
+			if(mColor)
+			{
+				row[0] = kColors[value][0];
+				row[1] = kColors[value][1];
+				row[2] = kColors[value][2];
+			}
+			else row[0] = kGrays[value];
+		}
+	}
+}
+
+void Preview::save(const jm::String &filename) const
+{
+	std::string header = (mColor ? "P6\n" : "P5\n")
+	                     + std::to_string(mWidth) + " " + std::to_string(mHeight) + "\n255\n";
+
+	std::vector<uint8> data(header.begin(), header.end());
+	data.insert(data.end(), mPixels.begin(), mPixels.end());
+	saveAtomic(filename, data.data(), data.size());
+}
+
+void Preview::saveHashes(const jm::String &filename) const
+{
+	std::string out;
+	char line[32];
+	for(size_t a = 0; a < mNumbers.size(); a++)
+	{
+		std::snprintf(line, sizeof(line), "%u %016llx\n", (uint32)mNumbers[a],
+		              (unsigned long long)mHashes[a]);
+		out.append(line);
+	}
+
+	saveAtomic(filename, (const uint8*)out.data(), out.size());
+}
+
+uint32 Preview::width() const
+{
+	return mWidth;
+}
+
+uint32 Preview::height() const
+{
+	return mHeight;
+}
@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Preview.h
+// Application: Shape File Compiler
+// Purpose:     Contact sheet of the shapes
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_Preview_h
+#define shpc_Preview_h
+
+#include <functional>
+#include <vector>
+
+#include "core/Core.h"
+
+#include "Outline.h"
+#include "ShapeTable.h"
+#include "ThreadPool.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The preview renders all shapes of a font into a contact sheet, one tile per shape in
+	 the order of the shape numbers. All shapes are drawn with one scale and origin, taken from the
+	 height of the font in shape 0 or else from the bounding box of all shapes, with lines of one
+	 pixel width. The tiles are separated by grid lines. In color, the start point of each shape is
+	 marked red.
+
+	 For each shape, a hash of its tile, its bounding box and its advance is determined, so that
+	 changes of the rendering can be found by comparing the hashes of two builds.
+	 */
+	class Preview
+	{
+		public:
+
+			// The default size of a tile in pixels.
+			static const uint32 kTileSize = 32;
+
+			Preview();
+
+			/*!
+			 \brief Sets the size of a tile in pixels including the grid line. Minimum is 8.
+			 */
+			void setTileSize(uint32 size);
+
+			/*!
+			 \brief Status whether the sheet has colors (PPM) or is grayscale (PGM). Default: false.
+			 */
+			void setColor(bool color);
+
+			/*!
+			 \brief Sets the thread pool, on which the tiles are rendered. If nullptr (default), all
+			 tiles are rendered in the calling thread. The pool must exist during the rendering.
+			 */
+			void setThreadPool(ThreadPool* pool);
+
+			/*!
+			 \brief Renders all shapes except shape 0. The spec bytes must be valid.
+			 \throws jm::Exception, if a subshape does not exist.
+			 */
+			void render(const ShapeTable &shapes, bool unicode);
+
+			/*!
+			 \brief Saves the sheet as binary PGM or PPM file.
+			 */
+			void save(const jm::String &filename) const;
+
+			/*!
+			 \brief Saves the hashes of the tiles as text file. Each line contains the shape number
+			 and the hash of its tile (hexadecimal).
+			 */
+			void saveHashes(const jm::String &filename) const;
+
+			/*!
+			 \brief Returns the width of the sheet in pixels.
+			 */
+			uint32 width() const;
+
+			/*!
+			 \brief Returns the height of the sheet in pixels.
+			 */
+			uint32 height() const;
+
+		private:
+
+			// The size of a tile in pixels.
+			uint32 mTileSize;
+
+			// Status whether the sheet has colors.
+			bool mColor;
+
+			// The thread pool or nullptr.
+			ThreadPool* mPool;
+
+			// The number of tiles in a row.
+			uint32 mColumns;
+
+			// The size of the sheet in pixels.
+			uint32 mWidth;
+			uint32 mHeight;
+
+			// The pixels, one or three bytes each, row by row from the top.
+			std::vector<uint8> mPixels;
+
+			// The shape numbers in the order of the tiles.
+			std::vector<uint16> mNumbers;
+
+			// The hashes of the tiles.
+			std::vector<uint64> mHashes;
+
+			// The lower left corner of the frame of all shapes.
+			Point mMinimum;
+
+			// The pixels per unit of the shapes.
+			float mScale;
+
+			uint32 innerSize() const;
+
+			bool fontFrame(const ShapeTable &shapes);
+
+			void forSections(uint32 count, const std::function<void(uint32, uint32)> &task);
+
+			void measureTiles(const ShapeTable &shapes,
+			                  bool unicode,
+			                  const std::vector<uint32> &order,
+			                  uint32 begin,
+			                  uint32 end,
+			                  std::vector<Point> &minimum,
+			                  std::vector<Point> &maximum) const;
+
+			void renderTiles(const ShapeTable &shapes,
+			                 bool unicode,
+			                 const std::vector<uint32> &order,
+			                 uint32 begin,
+			                 uint32 end);
+
+			void drawTile(const Outline &outline, uint32 tile, std::vector<uint8> &pixels);
+	};
+
+}
+
+#endif
@@ -0,0 +1,373 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Server.cpp
+// Application: Shape File Compiler
+// Purpose:     Compile server and client
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "Server.h"
+
+using namespace shpc;
+
+/*!
+ \brief The maximum size of a frame. Larger frames are rejected, so that a wrong length does not
+ exhaust the memory.
+ */
+static const uint32 kMaxFrame = 256 * 1024 * 1024;
+
+static void writeLE32(std::vector<uint8> &data, uint32 value)
+{
+	data.push_back((uint8)value);
+	data.push_back((uint8)(value >> 8));
+	data.push_back((uint8)(value >> 16));
+	data.push_back((uint8)(value >> 24));
+}
+
+static uint32 readLE32(const uint8* data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32)data[3] << 24);
+}
+
+#ifndef _WIN32
+
+/*!
+ \brief Reads exactly the number of bytes. Returns false, if the input ends before.
+ */
+static bool readFully(int handle, uint8* data, size_t length)
+{
+	while(length > 0)
+	{
+		ssize_t count = ::read(handle, data, length);
+		if(count <= 0)return false;
+		data += count;
+		length -= count;
+	}
+	return true;
+}
+
+/*!
+ \brief Writes exactly the number of bytes. Returns false, if the output is closed.
+ */
+static bool writeFully(int handle, const uint8* data, size_t length)
+{
+	while(length > 0)
+	{
+		ssize_t count = ::write(handle, data, length);
+		if(count <= 0)return false;
+		data += count;
+		length -= count;
+	}
+	return true;
+}
+
+/*!
+ \brief Reads one frame. Returns false at the end of the input.
+ */
+static bool readFrame(int handle, std::vector<uint8> &frame)
+{
+	uint8 header[4];
+	if(!readFully(handle, header, 4))return false;
+
+	uint32 length = readLE32(header);
+	if(length > kMaxFrame)throw jm::Exception("Frame too large.");
+
+	frame.resize(length);
+	return readFully(handle, frame.data(), length);
+}
+
+/*!
+ \brief Writes one frame. Returns false, if the output is closed.
+ */
+static bool writeFrame(int handle, const std::vector<uint8> &frame)
+{
+	std::vector<uint8> header;
+	writeLE32(header, (uint32)frame.size());
+	if(!writeFully(handle, header.data(), header.size()))return false;
+	return writeFully(handle, frame.data(), frame.size());
+}
+
+/*!
+ \brief Creates the address of the UNIX domain socket.
+ */
+static void socketAddress(const jm::String &path, struct sockaddr_un &address)
+{
+	jm::ByteArray cpath = path.toCString();
+	if((size_t)cpath.size() >= sizeof(address.sun_path))
+		throw jm::Exception("Socket path too long: " + path);
+
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	std::memcpy(address.sun_path, cpath.constData(), cpath.size());
+}
+
+#endif
+
+Server::Server()
+{
+	mPool = nullptr;
+}
+
+void Server::setThreadPool(ThreadPool* pool)
+{
+	mPool = pool;
+}
+
+std::vector<uint8> Server::respond(Compiler &compiler, const uint8* request, size_t length)
+{
+	bool success = false;
+	if(length > 0)
+	{
+		compiler.setVerbose((request[0] & 1) != 0);
+		success = compiler.compile(request + 1, length - 1);
+	}
+
+	std::vector<uint8> response;
+	response.push_back(success ? 1 : 0);
+
+	const std::vector<uint8> &shx = compiler.image().data();
+	uint32 size = success ? (uint32)shx.size() : 0;
+	writeLE32(response, size);
+	response.insert(response.end(), shx.begin(), shx.begin() + size);
+
+	std::vector<Diagnostic> diagnostics;
+	if(length > 0)diagnostics = compiler.diagnostics();
+	else diagnostics.push_back(Diagnostic(Severity::kError, 0, "Empty request."));
+
+	writeLE32(response, (uint32)diagnostics.size());
+	for(size_t a = 0; a < diagnostics.size(); a++)
+	{
+		const Diagnostic &diagnostic = diagnostics[a];
+		jm::ByteArray message = diagnostic.message.toCString();
+
+		response.push_back((uint8)diagnostic.severity);
+		writeLE32(response, diagnostic.line);
+		writeLE32(response, (uint32)message.size());
+		response.insert(response.end(),
+		                (const uint8*)message.constData(),
+		                (const uint8*)message.constData() + message.size());
+	}
+
+	return response;
+}
+
+#ifndef _WIN32
+
+void Server::serve(int input, int output)
+{
+	// The compiler is kept between the requests, so its memory is reused.
+	Compiler compiler;
+	compiler.setThreadPool(mPool);
+
+	std::vector<uint8> request;
+	while(readFrame(input, request))
+	{
+		std::vector<uint8> response = respond(compiler, request.data(), request.size());
+		if(!writeFrame(output, response))return;
+	}
+}
+
+void Server::listen(const jm::String &path)
+{
+	// A client, which disconnects early, must not stop the server.
+	signal(SIGPIPE, SIG_IGN);
+
+	struct sockaddr_un address;
+	socketAddress(path, address);
+
+	// A socket file of a previous server is replaced, but no other file.
+	struct stat status;
+	if(lstat(address.sun_path, &status) == 0)
+	{
+		if(!S_ISSOCK(status.st_mode))throw jm::Exception("Path exists and is no socket: " + path);
+		unlink(address.sun_path);
+	}
+
+	int handle = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(handle < 0)throw jm::Exception("Cannot create socket: " + path);
+
+	if(bind(handle, (struct sockaddr*)&address, sizeof(address)) != 0
+	      || ::listen(handle, SOMAXCONN) != 0)
+	{
+		close(handle);
+		throw jm::Exception("Cannot listen on socket: " + path);
+	}
+
+	while(true)
+	{
+		int client = accept(handle, nullptr, nullptr);
+		if(client < 0)
+		{
+			// Interrupted calls and clients, which disconnected before, are no errors.
+			if(errno == EINTR || errno == ECONNABORTED)continue;
+
+			// Without free file handles the server waits, until connections are closed.
+			if(errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(100));
+				continue;
+			}
+
+			int error = errno;
+			close(handle);
+			throw jm::Exception("Cannot accept connection: " + jm::String(std::strerror(error)));
+		}
+
+		std::thread([this, client]
+		{
+			try
+			{
+				serve(client, client);
+			}
+			catch(jm::Exception &)
+			{
+				// The connection is closed on invalid frames.
+			}
+			close(client);
+		}).detach();
+	}
+}
+
+Client::Client()
+{
+	mSocket = -1;
+}
+
+Client::~Client()
+{
+	if(mSocket >= 0)close(mSocket);
+}
+
+void Client::connect(const jm::String &path)
+{
+	struct sockaddr_un address;
+	socketAddress(path, address);
+
+	mSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(mSocket < 0)throw jm::Exception("Cannot create socket: " + path);
+
+	if(::connect(mSocket, (struct sockaddr*)&address, sizeof(address)) != 0)
+		throw jm::Exception("Cannot connect to server: " + path);
+}
+
+bool Client::compile(const uint8* data,
+                     size_t length,
+                     bool verbose,
+                     std::vector<uint8> &shx,
+                     std::vector<Diagnostic> &diagnostics)
+{
+	if(mSocket < 0)throw jm::Exception("Not connected.");
+
+	std::vector<uint8> frame;
+	frame.reserve(length + 1);
+	frame.push_back(verbose ? 1 : 0);
+	frame.insert(frame.end(), data, data + length);
+
+	if(!writeFrame(mSocket, frame) || !readFrame(mSocket, frame))
+		throw jm::Exception("Connection to server lost.");
+
+	// Each read checks, that the response contains enough bytes.
+	size_t position = 0;
+	if(frame.size() < 5)throw jm::Exception("Invalid response.");
+	bool success = frame[position++] != 0;
+
+	uint32 size = readLE32(frame.data() + position);
+	position += 4;
+	if(frame.size() - position < (size_t)size + 4)throw jm::Exception("Invalid response.");
+	shx.assign(frame.begin() + position, frame.begin() + position + size);
+	position += size;
+
+	uint32 count = readLE32(frame.data() + position);
+	position += 4;
+
+	diagnostics.clear();
+	for(uint32 a = 0; a < count; a++)
+	{
+		if(frame.size() - position < 9)throw jm::Exception("Invalid response.");
+		uint8 severity = frame[position];
+		uint32 line = readLE32(frame.data() + position + 1);
+		uint32 messageLength = readLE32(frame.data() + position + 5);
+		position += 9;
+
+		if(severity > 2 || frame.size() - position < messageLength)
+			throw jm::Exception("Invalid response.");
+
+		// Messages are UTF-8 encoded
+		std::string message((const char*)frame.data() + position, messageLength);
+		position += messageLength;
+
+		diagnostics.push_back(Diagnostic((Severity)severity, line, jm::String(message.c_str())));
+	}
+
+	return success;
+}
+
+#else
+
+void Server::serve(int, int)
+{
+	throw jm::Exception("The compile server is not supported on this platform.");
+}
+
+void Server::listen(const jm::String &)
+{
+	throw jm::Exception("The compile server is not supported on this platform.");
+}
+
+Client::Client()
+{
+	mSocket = -1;
+}
+
+Client::~Client()
+{
+}
+
+void Client::connect(const jm::String &)
+{
+	throw jm::Exception("The compile server is not supported on this platform.");
+}
+
+bool Client::compile(const uint8*, size_t, bool, std::vector<uint8> &, std::vector<Diagnostic> &)
+{
+	throw jm::Exception("The compile server is not supported on this platform.");
+}
+
+#endif
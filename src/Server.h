@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Server.h
+// Application: Shape File Compiler
+// Purpose:     Compile server and client
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_Server_h
+#define shpc_Server_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+#include "Compiler.h"
+#include "ThreadPool.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The compile server keeps running and compiles SHP files on request, so that the start of
+	 a process is not needed for each file. The server is used over stdin/stdout or a local UNIX
+	 domain socket.
+
+	 Requests and responses are frames: a 32-bit length (little endian) followed by as many bytes.
+	 A request contains one byte of flags (bit 0: verbose) followed by the content of the SHP file.
+	 A response contains:
+	 - 1 byte status (1: success, 0: failure)
+	 - 32-bit length and the content of the SHX file (empty on failure)
+	 - 32-bit number of diagnostics, each with 1 byte severity (0: info, 1: warning, 2: error),
+	   32-bit line, 32-bit length and the UTF-8 encoded message.
+
+	 All numbers are little endian. jm::System::init() must be called before the server is started.
+	 */
+	class Server
+	{
+		public:
+
+			Server();
+
+			/*!
+			 \brief Sets the thread pool for large files.
+			 */
+			void setThreadPool(ThreadPool* pool);
+
+			/*!
+			 \brief Answers the requests read from the input until the input ends.
+			 \param input File descriptor of the input, e.g. 0 for stdin.
+			 \param output File descriptor of the output, e.g. 1 for stdout.
+			 */
+			void serve(int input, int output);
+
+			/*!
+			 \brief Accepts clients on the UNIX domain socket. Each client is served in its own
+			 thread, so several clients can compile at once. A socket file at the path is
+			 replaced, other files are not.
+			 \throws jm::Exception, if the path exists and is no socket or on errors of the socket.
+			 */
+			void listen(const jm::String &path);
+
+			/*!
+			 \brief Compiles the request and returns the response without the frame length.
+			 */
+			static std::vector<uint8> respond(Compiler &compiler, const uint8* request, size_t length);
+
+		private:
+
+			// The pool for large files or nullptr.
+			ThreadPool* mPool;
+	};
+
+	/*!
+	 \brief A client of the compile server on a UNIX domain socket.
+	 */
+	class Client
+	{
+		public:
+
+			Client();
+
+			~Client();
+
+			/*!
+			 \brief Connects to the server. Throws an exception on failure.
+			 */
+			void connect(const jm::String &path);
+
+			/*!
+			 \brief Sends the SHP file content to the server and receives the result.
+			 \param data The content of the SHP file.
+			 \param length The number of bytes.
+			 \param verbose Status whether detailed information is requested.
+			 \param shx Receives the content of the SHX file.
+			 \param diagnostics Receives the messages of the compiler.
+			 \return true on success.
+			 */
+			bool compile(const uint8* data,
+			             size_t length,
+			             bool verbose,
+			             std::vector<uint8> &shx,
+			             std::vector<Diagnostic> &diagnostics);
+
+		private:
+
+			// The socket or -1.
+			int mSocket;
+	};
+
+}
+
+#endif
@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ShapeCache.cpp
+// Application: Shape File Compiler
+// Purpose:     Cache of compiled shapes for incremental compilation
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#include "AtomicFile.h"
+#include "MappedFile.h"
+#include "ShapeCache.h"
+
+using namespace shpc;
+
+/*!
+ \brief The first bytes of a cache file. The number changes with the format.
+ */
+static const char* kMagic = "shpc-cache 1\x1A";
+
+static const uint32 kMagicLength = 13;
+
+static uint16 readLE16(const uint8* data)
+{
+	return (uint16)(data[0] | (data[1] << 8));
+}
+
+static void writeLE16(std::vector<uint8> &data, uint16 value)
+{
+	data.push_back((uint8)value);
+	data.push_back((uint8)(value >> 8));
+}
+
+uint64 shpc::hash(const uint8* data, size_t length, uint64 seed)
+{
+	uint64 h = seed;
+	for(size_t a = 0; a < length; a++)
+	{
+		h ^= data[a];
+		h *= 0x100000001B3ULL;
+	}
+	return h;
+}
+
+ShapeCache::ShapeCache()
+{
+}
+
+jm::String ShapeCache::filename(const jm::String &shxname)
+{
+	return shxname + ".cache";
+}
+
+void ShapeCache::load(const jm::String &filename)
+{
+	clear();
+
+	jm::File file(filename);
+	if(!file.exists())return;
+
+	MappedFile mapped;
+	mapped.open(filename);
+
+	const uint8* data = mapped.data();
+	size_t size = mapped.size();
+	if(size < kMagicLength || std::memcmp(data, kMagic, kMagicLength) != 0)return;
+
+	// Each entry is the hash (64-bit little endian) followed by the data of the shape.
+	size_t position = kMagicLength;
+	while(position + 14 <= size)
+	{
+		uint64 key = 0;
+		for(uint32 a = 0; a < 8; a++)key |= (uint64)data[position + a] << (8 * a);
+		position += 8;
+
+		uint32 length = 6 + readLE16(data + position + 2) + readLE16(data + position + 4);
+		if(position + length > size)break;
+
+		mIndex[key] = (uint32)mData.size();
+		mData.insert(mData.end(), data + position, data + position + length);
+		position += length;
+	}
+
+	if(position != size)clear();
+}
+
+void ShapeCache::save(const jm::String &filename) const
+{
+	std::vector<uint8> data(kMagic, kMagic + kMagicLength);
+	data.reserve(kMagicLength + mData.size() + 8 * mIndex.size());
+
+	for(std::unordered_map<uint64, uint32>::const_iterator it = mIndex.begin();
+	      it != mIndex.end();
+	      ++it)
+	{
+		for(uint32 a = 0; a < 8; a++)data.push_back((uint8)(it->first >> (8 * a)));
+
+		const uint8* entry = mData.data() + it->second;
+		uint32 length = 6 + readLE16(entry + 2) + readLE16(entry + 4);
+		data.insert(data.end(), entry, entry + length);
+	}
+
+	saveAtomic(filename, data.data(), data.size());
+}
+
+void ShapeCache::clear()
+{
+	mIndex.clear();
+	mData.clear();
+}
+
+uint32 ShapeCache::size() const
+{
+	return (uint32)mIndex.size();
+}
+
+void ShapeCache::add(uint64 hash, const ShapeTable &shapes, uint32 index)
+{
+	if(mIndex.find(hash) != mIndex.end())return;
+
+	mIndex[hash] = (uint32)mData.size();
+	writeLE16(mData, shapes.number(index));
+	writeLE16(mData, shapes.defBytes(index));
+	writeLE16(mData, shapes.nameLength(index));
+
+	// The record contains the name with terminating zero, which is not stored.
+	const uint8* name = shapes.encodedName(index);
+	mData.insert(mData.end(), name, name + shapes.nameLength(index));
+
+	const uint8* buffer = shapes.buffer(index);
+	mData.insert(mData.end(), buffer, buffer + shapes.defBytes(index));
+}
+
+bool ShapeCache::restore(uint64 hash, ShapeTable &shapes) const
+{
+	std::unordered_map<uint64, uint32>::const_iterator it = mIndex.find(hash);
+	if(it == mIndex.end())return false;
+
+	const uint8* entry = mData.data() + it->second;
+	uint16 number = readLE16(entry);
+	uint16 defBytes = readLE16(entry + 2);
+	uint16 nameLength = readLE16(entry + 4);
+
+	uint32 index = shapes.add(number, defBytes, entry + 6, nameLength);
+
+	const uint8* buffer = entry + 6 + nameLength;
+	for(uint16 a = 0; a < defBytes; a++)shapes.append(index, buffer[a]);
+
+	return true;
+}
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ShapeCache.h
+// Application: Shape File Compiler
+// Purpose:     Cache of compiled shapes for incremental compilation
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_ShapeCache_h
+#define shpc_ShapeCache_h
+
+#include <unordered_map>
+#include <vector>
+
+#include "core/Core.h"
+
+#include "ShapeTable.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief Returns a 64-bit hash (FNV-1a) of the data.
+	 \param data The data.
+	 \param length The number of bytes.
+	 \param seed The start value, e.g. to separate different file types.
+	 */
+	uint64 hash(const uint8* data, size_t length, uint64 seed = 0xCBF29CE484222325ULL);
+
+	/*!
+	 \brief The cache holds the compiled shapes of the last successful compilation. Each shape is
+	 found by the hash of its source text, i.e. the header line and the spec byte lines. A shape,
+	 whose source text did not change, is taken from the cache without reading and checking the
+	 spec bytes again. The cache is stored in a sidecar file next to the SHX file. Lookups are
+	 thread safe as long as the cache is not modified.
+	 */
+	class ShapeCache
+	{
+		public:
+
+			ShapeCache();
+
+			/*!
+			 \brief Returns the name of the sidecar file for the SHX file.
+			 */
+			static jm::String filename(const jm::String &shxname);
+
+			/*!
+			 \brief Loads the cache from the file. If the file does not exist or is invalid, the
+			 cache is empty afterwards.
+			 */
+			void load(const jm::String &filename);
+
+			/*!
+			 \brief Saves the cache to a temporary file, which then replaces the target.
+			 */
+			void save(const jm::String &filename) const;
+
+			/*!
+			 \brief Removes all shapes.
+			 */
+			void clear();
+
+			/*!
+			 \brief Returns the number of shapes in the cache.
+			 */
+			uint32 size() const;
+
+			/*!
+			 \brief Adds the shape of the table with the hash of its source text.
+			 */
+			void add(uint64 hash, const ShapeTable &shapes, uint32 index);
+
+			/*!
+			 \brief Adds the shape with the hash to the table, if it is in the cache.
+			 \return false, if the cache does not contain the hash.
+			 */
+			bool restore(uint64 hash, ShapeTable &shapes) const;
+
+		private:
+
+			// The offsets of the entries in the data by hash.
+			std::unordered_map<uint64, uint32> mIndex;
+
+			// The entries: shape number, number of spec bytes and length of the name (each 16-bit
+			// little endian), followed by the name and the spec bytes.
+			std::vector<uint8> mData;
+	};
+
+}
+
+#endif
@@ -0,0 +1,309 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ShapeGraph.cpp
+// Application: Shape File Compiler
+// Purpose:     Subshape references of the shapes
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <string>
+
+#include "AtomicFile.h"
+#include "ShapeGraph.h"
+#include "SpecValidator.h"
+
+using namespace shpc;
+
+/*!
+ \brief Returns the shape number of the Subshape-Command (7) at the position.
+ */
+template<bool kUnicode>
+static inline uint16 subshapeNumber(const uint8* bytes, uint32 position)
+{
+	if(kUnicode)return (uint16)((bytes[position + 1] << 8) | bytes[position + 2]);
+	return bytes[position + 1];
+}
+
+/*!
+ \brief Adds the indexes of the shapes referenced by the shape to the targets.
+ */
+template<bool kUnicode>
+static void collect(const ShapeTable &shapes,
+                    uint32 index,
+                    const std::vector<uint32> &lookup,
+                    std::vector<uint32> &targets)
+{
+	const uint8* bytes = shapes.buffer(index);
+	uint32 length = shapes.defBytes(index);
+
+	uint32 position = 0;
+	while(position < length)
+	{
+		if(bytes[position] == 7)
+		{
+			uint16 number = subshapeNumber<kUnicode>(bytes, position);
+			uint32 target = lookup[number];
+			if(target == ShapeGraph::kNoShape)
+				throw jm::Exception("In shape \""
+				                    + shapes.name(index)
+				                    + "\": Subshape "
+				                    + jm::String::valueOf((int64)number)
+				                    + " not found.");
+			targets.push_back(target);
+		}
+		position += commandSize<kUnicode>(bytes, position);
+	}
+}
+
+/*!
+ \brief Appends the spec bytes of the shape with all references replaced by the spec bytes of the
+ subshapes. For the subshapes, the already flattened bytes are used, if they exist.
+ */
+template<bool kUnicode>
+static void inlineSubshapes(const ShapeTable &shapes,
+                           uint32 index,
+                           const std::vector<uint32> &lookup,
+                           const std::vector<std::vector<uint8> > &flat,
+                           std::vector<uint8> &out)
+{
+	const uint8* bytes = shapes.buffer(index);
+	uint32 length = shapes.defBytes(index);
+
+	bool afterDoNext = false;
+	uint32 position = 0;
+	while(position < length)
+	{
+		uint32 size = commandSize<kUnicode>(bytes, position);
+		if(bytes[position] == 7 && !afterDoNext)
+		{
+			uint32 target = lookup[subshapeNumber<kUnicode>(bytes, position)];
+			const uint8* sub = shapes.buffer(target);
+			uint32 subLength = shapes.defBytes(target);
+			if(flat[target].size() > 0)
+			{
+				sub = flat[target].data();
+				subLength = (uint32)flat[target].size();
+			}
+
+			// Without the final 0, which ends the subshape.
+			out.insert(out.end(), sub, sub + subLength - 1);
+		}
+		else out.insert(out.end(), bytes + position, bytes + position + size);
+
+		afterDoNext = bytes[position] == 14;
+		position += size;
+	}
+}
+
+/*!
+ \brief Appends the text as quoted DOT string.
+ */
+static void appendDot(std::string &out, const char* text)
+{
+	out.push_back('"');
+	for(const char* c = text; *c != 0; c++)
+	{
+		if(*c == '"' || *c == '\\')out.push_back('\\');
+		out.push_back(*c);
+	}
+	out.push_back('"');
+}
+
+const uint32 ShapeGraph::kNoShape;
+const uint32 ShapeGraph::kMaxNesting;
+
+ShapeGraph::ShapeGraph()
+{
+	mFirst.push_back(0);
+}
+
+void ShapeGraph::build(const ShapeTable &shapes, bool unicode)
+{
+	mIndex.assign(0x10000, kNoShape);
+	for(uint32 a = 0; a < shapes.size(); a++)mIndex[shapes.number(a)] = a;
+
+	mFirst.resize(shapes.size() + 1);
+	mTargets.clear();
+	mDepth.clear();
+	mOrder.clear();
+
+	for(uint32 a = 0; a < shapes.size(); a++)
+	{
+		mFirst[a] = (uint32)mTargets.size();
+
+		// The font information contains no commands.
+		if(shapes.number(a) == 0)continue;
+
+		if(unicode)collect<true>(shapes, a, mIndex, mTargets);
+		else collect<false>(shapes, a, mIndex, mTargets);
+	}
+	mFirst[shapes.size()] = (uint32)mTargets.size();
+}
+
+void ShapeGraph::analyze(const ShapeTable &shapes)
+{
+	uint32 count = size();
+	mDepth.assign(count, 0);
+	mOrder.clear();
+	mOrder.reserve(count);
+
+	// 0 = not visited, 1 = on the current path, 2 = finished
+	std::vector<uint8> state(count, 0);
+
+	// The current path with the next reference to follow for each shape.
+	std::vector<uint32> path;
+	std::vector<uint32> next;
+
+	for(uint32 root = 0; root < count; root++)
+	{
+		if(state[root] != 0)continue;
+
+		state[root] = 1;
+		path.push_back(root);
+		next.push_back(0);
+
+		while(path.size() > 0)
+		{
+			uint32 shape = path.back();
+
+			if(next.back() < referenceCount(shape))
+			{
+				uint32 target = reference(shape, next.back()++);
+
+				if(state[target] == 1)
+				{
+					jm::String cycle;
+					size_t a = path.size();
+					while(path[a - 1] != target)a--;
+					for(a = a - 1; a < path.size(); a++)cycle.append(shapes.name(path[a]) + " -> ");
+					cycle.append(shapes.name(target));
+
+					throw jm::Exception("In shape \""
+					                    + shapes.name(target)
+					                    + "\": Subshape cycle "
+					                    + cycle
+					                    + ".");
+				}
+
+				if(state[target] == 0)
+				{
+					state[target] = 1;
+					path.push_back(target);
+					next.push_back(0);
+				}
+				else if(mDepth[target] + 1 > mDepth[shape])mDepth[shape] = mDepth[target] + 1;
+			}
+			else
+			{
+				state[shape] = 2;
+				mOrder.push_back(shape);
+				path.pop_back();
+				next.pop_back();
+
+				if(path.size() > 0 && mDepth[shape] + 1 > mDepth[path.back()])
+					mDepth[path.back()] = mDepth[shape] + 1;
+			}
+		}
+	}
+}
+
+uint32 ShapeGraph::flatten(ShapeTable &shapes, bool unicode) const
+{
+	std::vector<std::vector<uint8> > flat(size());
+	uint32 failures = 0;
+	bool changed = false;
+
+	for(size_t a = 0; a < mOrder.size(); a++)
+	{
+		uint32 shape = mOrder[a];
+		if(referenceCount(shape) == 0)continue;
+
+		std::vector<uint8> &bytes = flat[shape];
+		if(unicode)inlineSubshapes<true>(shapes, shape, mIndex, flat, bytes);
+		else inlineSubshapes<false>(shapes, shape, mIndex, flat, bytes);
+
+		SpecResult result = unicode
+		                    ? validateSpec<true>(bytes.data(), (uint32)bytes.size())
+		                    : validateSpec<false>(bytes.data(), (uint32)bytes.size());
+
+		if(bytes.size() > 0xFFFF || result.error != SpecError::kNone)
+		{
+			bytes.clear();
+			failures++;
+		}
+		else changed = true;
+	}
+
+	if(changed)
+	{
+		shapes.transform([&flat](uint32 index, std::vector<uint8> &bytes)
+		{
+			if(flat[index].size() > 0)bytes.swap(flat[index]);
+		});
+	}
+
+	return failures;
+}
+
+void ShapeGraph::save(const jm::String &filename, const ShapeTable &shapes) const
+{
+	std::vector<uint8> used(size(), 0);
+	for(uint32 a = 0; a < size(); a++)
+	{
+		if(referenceCount(a) > 0)used[a] = 1;
+		for(uint32 b = 0; b < referenceCount(a); b++)used[reference(a, b)] = 1;
+	}
+
+	std::string out = "digraph shapes\n{\n";
+	char id[16];
+
+	for(uint32 a = 0; a < size(); a++)
+	{
+		if(used[a] == 0)continue;
+
+		// Names are UTF-8 encoded
+		std::snprintf(id, sizeof(id), "\tn%u", (uint32)shapes.number(a));
+		out.append(id);
+		out.append(" [label=");
+		appendDot(out, shapes.name(a).toCString().constData());
+		out.append("];\n");
+	}
+
+	for(uint32 a = 0; a < size(); a++)
+	{
+		for(uint32 b = 0; b < referenceCount(a); b++)
+		{
+			std::snprintf(id, sizeof(id), "\tn%u", (uint32)shapes.number(a));
+			out.append(id);
+			std::snprintf(id, sizeof(id), " -> n%u;\n", (uint32)shapes.number(reference(a, b)));
+			out.append(id);
+		}
+	}
+	out.append("}\n");
+
+	saveAtomic(filename, (const uint8*)out.data(), out.size());
+}
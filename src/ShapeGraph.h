@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ShapeGraph.h
+// Application: Shape File Compiler
+// Purpose:     Subshape references of the shapes
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_ShapeGraph_h
+#define shpc_ShapeGraph_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+#include "ShapeTable.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The graph of the subshape references (opcode 7) of the shapes of a font. The shape
+	 numbers are resolved by a dense index with one entry per possible shape number. The references
+	 are stored in one array in the order of the shapes.
+	 */
+	class ShapeGraph
+	{
+		public:
+
+			// Marks a shape number without shape in the index.
+			static const uint32 kNoShape = 0xFFFFFFFF;
+
+			// The nesting depth of subshapes, from which a warning is reported. Deeper nesting is
+			// legal, but slow to render and usually a mistake.
+			static const uint32 kMaxNesting = 8;
+
+			ShapeGraph();
+
+			/*!
+			 \brief Builds the graph of the shapes and resolves all subshape references. The spec
+			 bytes must be valid. Shape 0 of a font is font information and has no references.
+			 \throws jm::Exception, if a referenced shape does not exist.
+			 */
+			void build(const ShapeTable &shapes, bool unicode);
+
+			/*!
+			 \brief Checks the graph for cycles and determines the nesting depth of each shape in
+			 one depth-first pass over all shapes and references.
+			 \throws jm::Exception, if a shape refers to itself directly or indirectly.
+			 */
+			void analyze(const ShapeTable &shapes);
+
+			/*!
+			 \brief Returns the index of the shape with the number or kNoShape.
+			 */
+			uint32 find(uint16 number) const
+			{
+				return mIndex[number];
+			}
+
+			/*!
+			 \brief Returns the number of shapes in the graph.
+			 */
+			uint32 size() const
+			{
+				return (uint32)mFirst.size() - 1;
+			}
+
+			/*!
+			 \brief Returns the number of subshape references of the shape at the index.
+			 */
+			uint32 referenceCount(uint32 index) const
+			{
+				return mFirst[index + 1] - mFirst[index];
+			}
+
+			/*!
+			 \brief Returns the index of the n-th shape referenced by the shape at the index.
+			 */
+			uint32 reference(uint32 index, uint32 n) const
+			{
+				return mTargets[mFirst[index] + n];
+			}
+
+			/*!
+			 \brief Returns the total number of subshape references.
+			 */
+			uint32 references() const
+			{
+				return (uint32)mTargets.size();
+			}
+
+			/*!
+			 \brief Returns the nesting depth of the shape at the index. 0 for shapes without
+			 subshapes. Only valid after analyze().
+			 */
+			uint32 depth(uint32 index) const
+			{
+				return mDepth[index];
+			}
+
+			/*!
+			 \brief Returns the indexes of the shapes in an order, in which each shape comes after
+			 its subshapes. Only valid after analyze().
+			 */
+			const std::vector<uint32>& order() const
+			{
+				return mOrder;
+			}
+
+			/*!
+			 \brief Replaces the subshape references by the spec bytes of the subshapes without their
+			 final 0, so no subshape must be called when rendering. References after the
+			 Do-Next-Command (14) are kept, because only the first command of the subshape would
+			 depend on it. Shapes, which would become invalid, e.g. because the position stack
+			 overflows, are kept unchanged. Only valid after analyze().
+			 \return The number of shapes, which could not be flattened.
+			 */
+			uint32 flatten(ShapeTable &shapes, bool unicode) const;
+
+			/*!
+			 \brief Saves the graph in the DOT format of Graphviz. Each shape with references or
+			 referenced by another shape is a node labeled with its name.
+			 */
+			void save(const jm::String &filename, const ShapeTable &shapes) const;
+
+		private:
+
+			// The index of the shape for each shape number.
+			std::vector<uint32> mIndex;
+
+			// The position of the first reference of each shape in mTargets. The last entry is the
+			// total number of references.
+			std::vector<uint32> mFirst;
+
+			// The indexes of the referenced shapes.
+			std::vector<uint32> mTargets;
+
+			// The nesting depth of each shape.
+			std::vector<uint32> mDepth;
+
+			// The shapes in the order subshapes first.
+			std::vector<uint32> mOrder;
+	};
+
+}
+
+#endif
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ShapeTable.cpp
+// Application: Shape File Compiler
+// Purpose:     Table with all shapes of a font
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#include "ShapeTable.h"
+
+using namespace shpc;
+
+ShapeTable::ShapeTable()
+{
+}
+
+uint32 ShapeTable::add(uint16 number, uint16 defBytes, const uint8* name, uint32 nameLength)
+{
+	if(nameLength > 0xFFFF)throw jm::Exception("Shape name too long.");
+
+	uint32 offset = (uint32)mArena.size();
+
+	mNumber.push_back(number);
+	mDefBytes.push_back(defBytes);
+	mPosition.push_back(0);
+	mNameLength.push_back((uint16)nameLength);
+	mOffset.push_back(offset);
+
+	mArena.resize(offset + nameLength + 1 + defBytes);
+	if(nameLength > 0)std::memcpy(mArena.data() + offset, name, nameLength);
+	mArena[offset + nameLength] = 0;
+
+	return (uint32)mNumber.size() - 1;
+}
+
+void ShapeTable::merge(const ShapeTable &other)
+{
+	uint32 offset = (uint32)mArena.size();
+
+	mNumber.insert(mNumber.end(), other.mNumber.begin(), other.mNumber.end());
+	mDefBytes.insert(mDefBytes.end(), other.mDefBytes.begin(), other.mDefBytes.end());
+	mPosition.insert(mPosition.end(), other.mPosition.begin(), other.mPosition.end());
+	mNameLength.insert(mNameLength.end(), other.mNameLength.begin(), other.mNameLength.end());
+
+	for(size_t a = 0; a < other.mOffset.size(); a++)mOffset.push_back(offset + other.mOffset[a]);
+
+	mArena.insert(mArena.end(), other.mArena.begin(), other.mArena.end());
+}
+
+void ShapeTable::transform(const std::function<void(uint32 index, std::vector<uint8> &bytes)>
+                           &function)
+{
+	std::vector<uint8> arena;
+	arena.reserve(mArena.size());
+
+	std::vector<uint8> bytes;
+	for(uint32 a = 0; a < size(); a++)
+	{
+		bytes.assign(buffer(a), buffer(a) + mDefBytes[a]);
+		function(a, bytes);
+		if(bytes.size() > 0xFFFF)throw jm::Exception("Too many spec bytes in shape: " + name(a));
+
+		uint32 offset = (uint32)arena.size();
+		arena.insert(arena.end(), record(a), record(a) + mNameLength[a] + 1);
+		arena.insert(arena.end(), bytes.begin(), bytes.end());
+
+		mOffset[a] = offset;
+		mDefBytes[a] = (uint16)bytes.size();
+		mPosition[a] = (uint16)bytes.size();
+	}
+
+	mArena.swap(arena);
+}
+
+void ShapeTable::clear()
+{
+	mNumber.clear();
+	mDefBytes.clear();
+	mPosition.clear();
+	mNameLength.clear();
+	mOffset.clear();
+	mArena.clear();
+}
+
+void ShapeTable::reserve(uint32 arenaBytes)
+{
+	mArena.reserve(arenaBytes);
+}
+
+jm::String ShapeTable::name(uint32 index) const
+{
+	const uint8* name = encodedName(index);
+	jm::String str;
+	for(uint32 a = 0; a < mNameLength[index]; a++)
+	{
+		str.append(jm::Char(name[a]));
+	}
+	return str;
+}
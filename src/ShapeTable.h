@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ShapeTable.h
+// Application: Shape File Compiler
+// Purpose:     Table with all shapes of a font
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_ShapeTable_h
+#define shpc_ShapeTable_h
+
+#include <functional>
+#include <vector>
+
+#include "core/Core.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The table stores all shapes of a font. The fixed fields of the shapes are held in
+	 separate arrays (structure of arrays). The encoded names and the spec bytes are stored in one
+	 common arena. For each shape, the arena contains the record as it is written to the SHX file:
+	 the zero terminated name directly followed by the spec bytes. The records are in the order of
+	 the shapes, so that the arena can be written in one piece.
+	 */
+	class ShapeTable
+	{
+		public:
+
+			ShapeTable();
+
+			/*!
+			 \brief Adds a new shape and reserves the space for its spec bytes in the arena.
+			 \param number The shape number.
+			 \param defBytes The number of spec bytes of the shape.
+			 \param name The name of the shape, already encoded in the charset of the SHX file.
+			 \param nameLength The number of bytes of the name without terminating zero.
+			 \return The index of the new shape.
+			 */
+			uint32 add(uint16 number, uint16 defBytes, const uint8* name, uint32 nameLength);
+
+			/*!
+			 \brief Appends all shapes of the other table behind the shapes of this table.
+			 */
+			void merge(const ShapeTable &other);
+
+			/*!
+			 \brief Rewrites the spec bytes of all shapes. The function is called for each shape with
+			 its index and a copy of its spec bytes, which it may change. Then the arena is rebuilt
+			 once.
+			 */
+			void transform(const std::function<void(uint32 index, std::vector<uint8> &bytes)>
+			               &function);
+
+			/*!
+			 \brief Removes all shapes. The allocated memory is kept for reuse.
+			 */
+			void clear();
+
+			/*!
+			 \brief Reserves memory for the given number of arena bytes.
+			 */
+			void reserve(uint32 arenaBytes);
+
+			/*!
+			 \brief Returns the number of shapes.
+			 */
+			uint32 size() const
+			{
+				return (uint32)mNumber.size();
+			}
+
+			/*!
+			 \brief Returns the shape number of the shape at the index.
+			 */
+			uint16 number(uint32 index) const
+			{
+				return mNumber[index];
+			}
+
+			/*!
+			 \brief Returns the number of spec bytes of the shape at the index.
+			 */
+			uint16 defBytes(uint32 index) const
+			{
+				return mDefBytes[index];
+			}
+
+			/*!
+			 \brief Returns the number of spec bytes already assigned to the shape during reading.
+			 */
+			uint16 position(uint32 index) const
+			{
+				return mPosition[index];
+			}
+
+			/*!
+			 \brief Appends a spec byte to the shape at the index. The caller has to ensure, that the
+			 number of spec bytes is not exceeded.
+			 */
+			void append(uint32 index, uint8 specByte)
+			{
+				mArena[mOffset[index] + mNameLength[index] + 1 + mPosition[index]++] = specByte;
+			}
+
+			/*!
+			 \brief Returns the spec bytes of the shape at the index.
+			 */
+			const uint8* buffer(uint32 index) const
+			{
+				return mArena.data() + mOffset[index] + mNameLength[index] + 1;
+			}
+
+			/*!
+			 \brief Returns the zero terminated, encoded name of the shape at the index.
+			 */
+			const uint8* encodedName(uint32 index) const
+			{
+				return mArena.data() + mOffset[index];
+			}
+
+			/*!
+			 \brief Returns the number of bytes of the encoded name without terminating zero.
+			 */
+			uint16 nameLength(uint32 index) const
+			{
+				return mNameLength[index];
+			}
+
+			/*!
+			 \brief Returns the name of the shape at the index as string, e.g. for messages.
+			 */
+			jm::String name(uint32 index) const;
+
+			/*!
+			 \brief Returns the record of the shape, i.e. the name with terminating zero followed by
+			 the spec bytes.
+			 */
+			const uint8* record(uint32 index) const
+			{
+				return mArena.data() + mOffset[index];
+			}
+
+			/*!
+			 \brief Returns the number of bytes of the record of the shape.
+			 */
+			uint32 recordLength(uint32 index) const
+			{
+				return mNameLength[index] + 1 + mDefBytes[index];
+			}
+
+			/*!
+			 \brief Returns the records of all shapes in one piece.
+			 */
+			const uint8* arena() const
+			{
+				return mArena.data();
+			}
+
+			/*!
+			 \brief Returns the number of bytes of all records.
+			 */
+			uint32 arenaSize() const
+			{
+				return (uint32)mArena.size();
+			}
+
+		private:
+
+			// The shape numbers.
+			std::vector<uint16> mNumber;
+
+			// The number of spec bytes of each shape.
+			std::vector<uint16> mDefBytes;
+
+			// The number of spec bytes assigned during reading.
+			std::vector<uint16> mPosition;
+
+			// The length of the encoded names.
+			std::vector<uint16> mNameLength;
+
+			// The offset of the records in the arena.
+			std::vector<uint32> mOffset;
+
+			// Names and spec bytes of all shapes.
+			std::vector<uint8> mArena;
+	};
+
+}
+
+#endif
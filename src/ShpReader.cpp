@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ShpReader.cpp
+// Application: Shape File Compiler
+// Purpose:     Block-buffered reader for SHP files
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#include "ShpReader.h"
+
+using namespace shpc;
+
+/*!
+ \brief Size of a block during reading the file.
+ */
+static const int64 kBlockSize = 65536;
+
+static const uint64 kOnes = 0x0101010101010101ULL;
+static const uint64 kHighBits = 0x8080808080808080ULL;
+
+/*!
+ \brief Returns a value not equal to 0, if one of the 8 bytes in the word is zero.
+ */
+static inline uint64 hasZeroByte(uint64 word)
+{
+	return (word - kOnes) & ~word & kHighBits;
+}
+
+/*!
+ \brief Searches for the first line end (CR or LF) from "begin" on. If "semicolon" is true, the
+ search also stops at the first semicolon. Returns "end" if nothing was found. The bytes are tested
+ 8 at a time. Only if a word contains a hit, it is examined byte by byte.
+ */
+static const uint8* findDelimiter(const uint8* begin, const uint8* end, bool semicolon)
+{
+	const uint64 lf = kOnes * '\n';
+	const uint64 cr = kOnes * '\r';
+	const uint64 sc = kOnes * ';';
+
+	const uint8* p = begin;
+
+	while(end - p >= 8)
+	{
+		uint64 word;
+		std::memcpy(&word, p, 8);
+
+		uint64 hit = hasZeroByte(word ^ lf) | hasZeroByte(word ^ cr);
+		if(semicolon) hit |= hasZeroByte(word ^ sc);
+		if(hit != 0)break;
+
+		p += 8;
+	}
+
+	while(p < end)
+	{
+		uint8 c = *p;
+		if(c == '\n' || c == '\r' || (semicolon && c == ';'))return p;
+		p++;
+	}
+
+	return end;
+}
+
+ShpReader::ShpReader()
+{
+	mData = nullptr;
+	mSize = 0;
+	mPosition = 0;
+}
+
+void ShpReader::load(jm::File* file)
+{
+	mBuffer.clear();
+	mPosition = 0;
+
+	// Reserve one block more than the file size, so that the final read attempt does not grow the
+	// buffer again.
+	int64 size = file->size();
+	if(size > 0)mBuffer.reserve((size_t)(size + kBlockSize));
+
+	size_t filled = 0;
+	while(true)
+	{
+		mBuffer.resize(filled + kBlockSize);
+		int64 count = file->read(mBuffer.data() + filled, kBlockSize);
+		if(count <= 0)break;
+		filled += (size_t)count;
+	}
+	mBuffer.resize(filled);
+
+	mData = mBuffer.data();
+	mSize = mBuffer.size();
+}
+
+void ShpReader::load(const uint8* data, size_t length)
+{
+	mBuffer.clear();
+	mData = data;
+	mSize = length;
+	mPosition = 0;
+}
+
+bool ShpReader::nextLine(ShpLine &line)
+{
+	if(mPosition >= mSize)return false;
+
+	const uint8* begin = mData + mPosition;
+	const uint8* end = mData + mSize;
+
+	// Everything after a semicolon is comment
+	const uint8* stop = findDelimiter(begin, end, true);
+	const uint8* eol = stop;
+	if(stop < end && *stop == ';')eol = findDelimiter(stop, end, false);
+
+	line.data = begin;
+	line.codeLength = (uint32)(stop - begin);
+	line.length = (uint32)(eol - begin);
+
+	// Skip the line end. CR LF counts as one line end, so that line numbers are correct.
+	mPosition += line.length;
+	if(eol < end)
+	{
+		mPosition++;
+		if(*eol == '\r' && eol + 1 < end && eol[1] == '\n')mPosition++;
+	}
+
+	return true;
+}
@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ShpReader.h
+// Application: Shape File Compiler
+// Purpose:     Block-buffered reader for SHP files
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_ShpReader_h
+#define shpc_ShpReader_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief View on one line of the SHP file. The view points directly into the buffer of the reader
+	 and is only valid as long as the reader exists.
+	 */
+	struct ShpLine
+	{
+		// Pointer to the first byte of the line.
+		const uint8* data;
+
+		// Number of bytes up to the line end.
+		uint32 length;
+
+		// Number of bytes before the first semicolon, i.e. the line without comment.
+		uint32 codeLength;
+
+		ShpLine()
+		{
+			data = nullptr;
+			length = 0;
+			codeLength = 0;
+		}
+	};
+
+	/*!
+	 \brief The reader loads the complete SHP file in large blocks into memory and splits it into
+	 lines. Line ends and comment starts are searched word by word, so that no string is created per
+	 line.
+	 */
+	class ShpReader
+	{
+		public:
+
+			ShpReader();
+
+			/*!
+			 \brief Reads the complete content of the opened file into the buffer of the reader.
+			 */
+			void load(jm::File* file);
+
+			/*!
+			 \brief Uses the given file content. The data is not copied and must stay valid as long as
+			 the lines are used.
+			 */
+			void load(const uint8* data, size_t length);
+
+			/*!
+			 \brief Determines the next line of the file. Returns false if the end of the buffer was
+			 reached.
+			 */
+			bool nextLine(ShpLine &line);
+
+			/*!
+			 \brief Returns the position of the next line in the file.
+			 */
+			size_t position() const
+			{
+				return mPosition;
+			}
+
+			/*!
+			 \brief Sets the position of the next line. The position must be the start of a line.
+			 */
+			void seek(size_t position)
+			{
+				mPosition = position < mSize ? position : mSize;
+			}
+
+			/*!
+			 \brief Returns the number of bytes of the file.
+			 */
+			size_t size() const
+			{
+				return mSize;
+			}
+
+			/*!
+			 \brief Returns the content of the file.
+			 */
+			const uint8* data() const
+			{
+				return mData;
+			}
+
+		private:
+
+			// The content of the file, if it was read by the reader itself.
+			std::vector<uint8> mBuffer;
+
+			// The content of the file.
+			const uint8* mData;
+
+			// The number of bytes of the file.
+			size_t mSize;
+
+			// Position of the next line in the buffer.
+			size_t mPosition;
+
+	};
+
+}
+
+#endif
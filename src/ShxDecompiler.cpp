@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ShxDecompiler.cpp
+// Application: Shape File Compiler
+// Purpose:     Conversion of SHX files into SHP files
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "AtomicFile.h"
+#include "ShxDecompiler.h"
+
+using namespace shpc;
+
+// The number of shapes decompiled by one task.
+static const uint32 kShapesPerTask = 1024;
+
+// The number of spec bytes in one line of the SHP file.
+static const uint32 kBytesPerLine = 16;
+
+static const char kHex[] = "0123456789ABCDEF";
+
+ShxDecompiler::ShxDecompiler()
+{
+	mPool = nullptr;
+}
+
+void ShxDecompiler::setThreadPool(ThreadPool* pool)
+{
+	mPool = pool;
+}
+
+void ShxDecompiler::load(const jm::String &filename)
+{
+	mText.clear();
+	mFont.load(filename);
+
+	// Builds the index, so that a corrupt file is reported here.
+	mFont.size();
+}
+
+void ShxDecompiler::load(const uint8* data, size_t length)
+{
+	mText.clear();
+	mFont.load(data, length);
+	mFont.size();
+}
+
+void ShxDecompiler::decompile()
+{
+	mText.clear();
+	checkNames();
+
+	if(mFont.format() == ShxFormat::kBigfont)writeBigfontHeader(mText);
+
+	uint32 count = mFont.size();
+	if(mPool == nullptr || count <= kShapesPerTask)
+	{
+		write(0, count, mText);
+		return;
+	}
+
+	// Each task writes its shapes into its own text, the texts are joined in order.
+	std::vector<std::string> texts((count + kShapesPerTask - 1) / kShapesPerTask);
+
+	TaskGroup group;
+	for(size_t a = 0; a < texts.size(); a++)
+	{
+		uint32 begin = (uint32)a * kShapesPerTask;
+		uint32 end = std::min(begin + kShapesPerTask, count);
+		std::string* text = &texts[a];
+		mPool->submit([this, begin, end, text]
+		{
+			write(begin, end, *text);
+		}, &group);
+	}
+	mPool->wait(group);
+
+	size_t size = 0;
+	for(size_t a = 0; a < texts.size(); a++)size += texts[a].size();
+	mText.reserve(mText.size() + size);
+	for(size_t a = 0; a < texts.size(); a++)mText.append(texts[a]);
+}
+
+/*!
+ \brief Checks, that the names can be written into a SHP file. The compiler ends a name at a comma,
+ a semicolon starts a comment and a line break ends the header line. SHP files have no escapes for
+ them, so such names of foreign SHX files cannot be decompiled without changing the font.
+ */
+void ShxDecompiler::checkNames() const
+{
+	uint32 count = mFont.size();
+	for(uint32 a = 0; a < count; a++)
+	{
+		ShxShape shape = mFont.shape(a);
+		for(uint16 b = 0; b < shape.nameLength; b++)
+		{
+			uint8 c = shape.name[b];
+			if(c == ',' || c == ';' || c == '\r' || c == '\n')
+				throw jm::Exception("Shape " + jm::String::valueOf((int64)shape.number)
+				                    + ": The name \"" + mFont.name(a)
+				                    + "\" cannot be written into a SHP file.");
+		}
+	}
+}
+
+/*!
+ \brief Writes the shapes from begin to end as SHP text.
+ */
+void ShxDecompiler::write(uint32 begin, uint32 end, std::string &out) const
+{
+	bool unicode = mFont.isUnicode();
+	bool version11 = mFont.format() == ShxFormat::kShapes11;
+	bool bigfont = mFont.format() == ShxFormat::kBigfont;
+
+	char header[32];
+	for(uint32 a = begin; a < end; a++)
+	{
+		ShxShape shape = mFont.shape(a);
+
+		// The compiler determines the file type from the first header: "*UNIFONT," gives a
+		// Unicode font and "*0," shapes 1.1. So shape 0 of shapes 1.0 is written hexadecimal.
+		// Bigfonts start with their own header line.
+		if(unicode && shape.number == 0)std::strcpy(header, "*UNIFONT");
+		else if(unicode || (bigfont && shape.number > 0xFF))
+			std::snprintf(header, sizeof(header), "*0%04X", shape.number);
+		else if(shape.number == 0 && !version11 && !bigfont)std::strcpy(header, "*00");
+		else std::snprintf(header, sizeof(header), "*%u", shape.number);
+		out.append(header);
+
+		std::snprintf(header, sizeof(header), ",%u,", shape.defBytes);
+		out.append(header);
+
+		// The compiler takes the bytes of the name as they are.
+		out.append((const char*)shape.name, shape.nameLength);
+		out.push_back('\n');
+
+		const uint8* bytes = shape.specBytes;
+		for(uint32 b = 0; b < shape.defBytes; b++)
+		{
+			out.push_back('0');
+			out.push_back(kHex[bytes[b] >> 4]);
+			out.push_back(kHex[bytes[b] & 0x0F]);
+
+			if(b + 1 == shape.defBytes)out.push_back('\n');
+			else if(b % kBytesPerLine == kBytesPerLine - 1)out.append(",\n");
+			else out.push_back(',');
+		}
+	}
+}
+
+/*!
+ \brief Writes the header line of a bigfont with the number of shapes and the escape ranges.
+ */
+void ShxDecompiler::writeBigfontHeader(std::string &out) const
+{
+	const std::vector<EscapeRange> &ranges = mFont.escapeRanges();
+
+	char text[32];
+	std::snprintf(text, sizeof(text), "*BIGFONT %u,%u", mFont.size(), (uint32)ranges.size());
+	out.append(text);
+
+	for(size_t a = 0; a < ranges.size(); a++)
+	{
+		std::snprintf(text, sizeof(text), ",0%02X,0%02X", ranges[a].first, ranges[a].last);
+		out.append(text);
+	}
+	out.push_back('\n');
+}
+
+void ShxDecompiler::save(const jm::String &filename) const
+{
+	saveAtomic(filename, (const uint8*)mText.data(), mText.size());
+}
+
+const std::string& ShxDecompiler::text() const
+{
+	return mText;
+}
+
+bool ShxDecompiler::isUnicode() const
+{
+	return mFont.isUnicode();
+}
+
+uint32 ShxDecompiler::size() const
+{
+	return mFont.size();
+}
+
+uint16 ShxDecompiler::number(uint32 index) const
+{
+	return mFont.shape(index).number;
+}
+
+jm::String ShxDecompiler::name(uint32 index) const
+{
+	return mFont.name(index);
+}
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ShxDecompiler.h
+// Application: Shape File Compiler
+// Purpose:     Conversion of SHX files into SHP files
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_ShxDecompiler_h
+#define shpc_ShxDecompiler_h
+
+#include <string>
+
+#include "core/Core.h"
+
+#include "ShxFont.h"
+#include "ThreadPool.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The decompiler converts a SHX file back into a SHP file. It reads all file types,
+	 which the compiler writes: unifont 1.0, shapes 1.1, shapes 1.0 and bigfont 1.0. The shapes
+	 are not copied, each one refers to its record in the mapped file.
+
+	 The SHP file is canonical: each shape is written as header line followed by its spec bytes as
+	 hexadecimal numbers, 16 per line. Compiling the SHP file gives the same SHX file again.
+	 */
+	class ShxDecompiler
+	{
+		public:
+
+			ShxDecompiler();
+
+			/*!
+			 \brief Sets the thread pool, on which large fonts are decompiled. If nullptr (default),
+			 all shapes are decompiled in the calling thread. The pool must exist during the
+			 decompilation.
+			 */
+			void setThreadPool(ThreadPool* pool);
+
+			/*!
+			 \brief Maps the SHX file and reads its shape table.
+			 \throws jm::Exception, if the file cannot be read or is corrupt.
+			 */
+			void load(const jm::String &filename);
+
+			/*!
+			 \brief Reads the shape table of the given file content. The data is not copied and must
+			 stay valid as long as the decompiler is used.
+			 \throws jm::Exception, if the file is corrupt.
+			 */
+			void load(const uint8* data, size_t length);
+
+			/*!
+			 \brief Creates the text of the SHP file.
+			 \throws jm::Exception, if a name contains a character, which ends the name in a SHP
+			 file: a comma, a semicolon or a line break.
+			 */
+			void decompile();
+
+			/*!
+			 \brief Saves the text of the SHP file.
+			 */
+			void save(const jm::String &filename) const;
+
+			/*!
+			 \brief Returns the text of the SHP file.
+			 */
+			const std::string& text() const;
+
+			/*!
+			 \brief Status whether the file is a Unicode font.
+			 */
+			bool isUnicode() const;
+
+			/*!
+			 \brief Returns the number of shapes.
+			 */
+			uint32 size() const;
+
+			/*!
+			 \brief Returns the shape number of the shape at the index.
+			 */
+			uint16 number(uint32 index) const;
+
+			/*!
+			 \brief Returns the name of the shape at the index, decoded from Windows-1252.
+			 */
+			jm::String name(uint32 index) const;
+
+		private:
+
+			// The shapes of the SHX file.
+			ShxFont mFont;
+
+			// The thread pool or nullptr.
+			ThreadPool* mPool;
+
+			// The text of the SHP file.
+			std::string mText;
+
+			void checkNames() const;
+
+			void write(uint32 begin, uint32 end, std::string &out) const;
+
+			void writeBigfontHeader(std::string &out) const;
+	};
+
+}
+
+#endif
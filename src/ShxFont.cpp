@@ -0,0 +1,314 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ShxFont.cpp
+// Application: Shape File Compiler
+// Purpose:     Read only access to SHX files
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+
+#include "Compiler.h"
+#include "ShxFont.h"
+
+using namespace shpc;
+
+static uint16 readLE16(const uint8* data)
+{
+	return (uint16)(data[0] | (data[1] << 8));
+}
+
+/*!
+ \brief Status whether the data starts with the string of the file type.
+ */
+static bool startsWith(const uint8* data, size_t length, ShxFormat format)
+{
+	size_t size = std::strlen(filetype(format));
+	return length >= size && std::memcmp(data, filetype(format), size) == 0;
+}
+
+const uint32 ShxFont::kNotFound;
+
+ShxFont::ShxFont(): mIndexed(false)
+{
+	mData = nullptr;
+	mSize = 0;
+	mFormat = ShxFormat::kShapes10;
+}
+
+void ShxFont::load(const jm::String &filename)
+{
+	mFile.open(filename);
+	load(mFile.data(), mFile.size());
+}
+
+void ShxFont::load(const uint8* data, size_t length)
+{
+	mData = data;
+	mSize = length;
+	mHeaders.clear();
+	mLookup.clear();
+	mEscapes.clear();
+	mIndexed = false;
+
+	if(startsWith(data, length, ShxFormat::kUnifont))mFormat = ShxFormat::kUnifont;
+	else if(startsWith(data, length, ShxFormat::kShapes11))mFormat = ShxFormat::kShapes11;
+	else if(startsWith(data, length, ShxFormat::kShapes10))mFormat = ShxFormat::kShapes10;
+	else if(startsWith(data, length, ShxFormat::kBigfont))mFormat = ShxFormat::kBigfont;
+	else throw jm::Exception("Unknown SHX file type.");
+}
+
+ShxFormat ShxFont::format() const
+{
+	return mFormat;
+}
+
+bool ShxFont::isUnicode() const
+{
+	return mFormat == ShxFormat::kUnifont;
+}
+
+const std::vector<EscapeRange>& ShxFont::escapeRanges() const
+{
+	index();
+	return mEscapes;
+}
+
+uint32 ShxFont::size() const
+{
+	index();
+	return (uint32)mHeaders.size();
+}
+
+uint32 ShxFont::find(uint16 number) const
+{
+	index();
+
+	if(dense())return number < mLookup.size() ? mLookup[number] : kNotFound;
+
+	std::vector<uint32>::const_iterator it;
+	it = std::lower_bound(mLookup.begin(),
+	                      mLookup.end(),
+	                      number,
+	                      [this](uint32 index, uint16 value)
+	{
+		return mHeaders[index].number < value;
+	});
+
+	if(it == mLookup.end() || mHeaders[*it].number != number)return kNotFound;
+	return *it;
+}
+
+ShxShape ShxFont::shape(uint32 index) const
+{
+	this->index();
+
+	const Header &header = mHeaders[index];
+	ShxShape shape;
+	shape.number = header.number;
+	shape.name = mData + header.offset;
+	shape.nameLength = header.nameLength;
+	shape.specBytes = shape.name + header.nameLength + 1;
+	shape.defBytes = (uint16)(header.length - header.nameLength - 1);
+	return shape;
+}
+
+jm::String ShxFont::name(uint32 index) const
+{
+	ShxShape shape = this->shape(index);
+	return jm::String((const char*)shape.name, shape.nameLength, windowsCharset());
+}
+
+/*!
+ \brief Builds the index, if this was not done yet. The first thread builds it, the others wait.
+ If the file is corrupt, each call throws the exception again.
+ */
+void ShxFont::index() const
+{
+	if(mIndexed.load(std::memory_order_acquire))return;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	if(mIndexed.load(std::memory_order_relaxed))return;
+
+	// The index is a cache of the file content, which does not change the font itself.
+	const_cast<ShxFont*>(this)->build();
+	mIndexed.store(true, std::memory_order_release);
+}
+
+void ShxFont::build()
+{
+	mHeaders.clear();
+	mLookup.clear();
+	mEscapes.clear();
+
+	size_t position = std::strlen(filetype(mFormat));
+	if(mFormat == ShxFormat::kUnifont)readUnicode(position);
+	else if(mFormat == ShxFormat::kBigfont)readBigfont(position);
+	else readNormal(position);
+
+	if(dense())
+	{
+		// Dense table over all shape numbers up to the highest one. The first shape of a number
+		// wins.
+		uint16 high = 0;
+		for(size_t a = 0; a < mHeaders.size(); a++)high = std::max(high, mHeaders[a].number);
+		mLookup.assign(mHeaders.empty() ? 0 : (size_t)high + 1, kNotFound);
+		for(size_t a = 0; a < mHeaders.size(); a++)
+		{
+			uint32 &slot = mLookup[mHeaders[a].number];
+			if(slot == kNotFound)slot = (uint32)a;
+		}
+	}
+	else
+	{
+		// The compiler writes the shapes in ascending order, other tools may not.
+		mLookup.resize(mHeaders.size());
+		for(size_t a = 0; a < mHeaders.size(); a++)mLookup[a] = (uint32)a;
+		std::stable_sort(mLookup.begin(), mLookup.end(), [this](uint32 a, uint32 b)
+		{
+			return mHeaders[a].number < mHeaders[b].number;
+		});
+	}
+}
+
+/*!
+ \brief Status whether the shapes are found by a dense table. Unifonts and bigfonts use the whole
+ range of shape numbers and usually have many shapes.
+ */
+bool ShxFont::dense() const
+{
+	return mFormat == ShxFormat::kUnifont || mFormat == ShxFormat::kBigfont;
+}
+
+/*!
+ \brief Reads the shapes of a Unicode font. Each record directly follows its shape number and
+ length.
+ */
+void ShxFont::readUnicode(size_t position)
+{
+	if(position + 2 > mSize)throw jm::Exception("Corrupt SHX file. Number of shapes missing.");
+	uint16 count = readLE16(mData + position);
+	position += 2;
+
+	mHeaders.reserve(count);
+	for(uint32 a = 0; a < count; a++)
+	{
+		if(position + 4 > mSize)throw jm::Exception("Corrupt SHX file. Shape header missing.");
+		uint16 number = readLE16(mData + position);
+		uint16 length = readLE16(mData + position + 2);
+		position += 4;
+
+		mHeaders.push_back(header(number, position, length));
+		position += length;
+	}
+}
+
+/*!
+ \brief Reads the shapes of a normal font. The table of shape numbers and lengths is followed by
+ the records of all shapes in the same order.
+ */
+void ShxFont::readNormal(size_t position)
+{
+	if(position + 6 > mSize)throw jm::Exception("Corrupt SHX file. Shape range missing.");
+	uint16 count = readLE16(mData + position + 4);
+	position += 6;
+
+	const uint8* table = mData + position;
+	if(position + 4 * (size_t)count > mSize)
+		throw jm::Exception("Corrupt SHX file. Shape table truncated.");
+	position += 4 * (size_t)count;
+
+	mHeaders.reserve(count);
+	for(uint32 a = 0; a < count; a++)
+	{
+		uint16 number = readLE16(table + 4 * a);
+		uint16 length = readLE16(table + 4 * a + 2);
+
+		mHeaders.push_back(header(number, position, length));
+		position += length;
+	}
+}
+
+/*!
+ \brief Reads the shapes of a bigfont. The escape ranges are followed by an index with the number,
+ the length and the file position of each shape. Empty entries of the index are skipped.
+ */
+void ShxFont::readBigfont(size_t position)
+{
+	if(position + 6 > mSize)throw jm::Exception("Corrupt SHX file. Bigfont header missing.");
+	uint16 count = readLE16(mData + position + 2);
+	uint16 ranges = readLE16(mData + position + 4);
+	position += 6;
+
+	if(position + 4 * (size_t)ranges > mSize)
+		throw jm::Exception("Corrupt SHX file. Escape ranges truncated.");
+	for(uint32 a = 0; a < ranges; a++)
+	{
+		EscapeRange range;
+		range.first = (uint8)readLE16(mData + position);
+		range.last = (uint8)readLE16(mData + position + 2);
+		mEscapes.push_back(range);
+		position += 4;
+	}
+
+	const uint8* table = mData + position;
+	if(position + 8 * (size_t)count > mSize)
+		throw jm::Exception("Corrupt SHX file. Shape table truncated.");
+
+	mHeaders.reserve(count);
+	for(uint32 a = 0; a < count; a++)
+	{
+		const uint8* entry = table + 8 * a;
+		uint16 number = readLE16(entry);
+		uint16 length = readLE16(entry + 2);
+		uint32 offset = (uint32)readLE16(entry + 4) | ((uint32)readLE16(entry + 6) << 16);
+		if(number == 0 && length == 0 && offset == 0)continue;
+
+		mHeaders.push_back(header(number, offset, length));
+	}
+}
+
+/*!
+ \brief Checks the record and splits it into the name and the spec bytes.
+ */
+ShxFont::Header ShxFont::header(uint16 number, size_t offset, uint16 length) const
+{
+	if(offset + length > mSize)throw jm::Exception("Corrupt SHX file. Shape truncated.");
+
+	const uint8* record = mData + offset;
+	const uint8* end = (const uint8*)std::memchr(record, 0, length);
+	if(end == nullptr)
+		throw jm::Exception("Corrupt SHX file. Name of shape "
+		                    + jm::String::valueOf((int64)number) + " not terminated.");
+
+	Header header;
+	header.number = number;
+	header.nameLength = (uint16)(end - record);
+	header.length = length;
+	header.offset = (uint32)offset;
+	return header;
+}
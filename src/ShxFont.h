@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ShxFont.h
+// Application: Shape File Compiler
+// Purpose:     Read only access to SHX files
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_ShxFont_h
+#define shpc_ShxFont_h
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "core/Core.h"
+
+#include "MappedFile.h"
+#include "ShxImage.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief View on a shape in a SHX file. The pointers refer directly to the file and are valid as
+	 long as the font is loaded.
+	 */
+	struct ShxShape
+	{
+		// The shape number.
+		uint16 number;
+
+		// The name, encoded in Windows-1252, without terminating zero.
+		const uint8* name;
+
+		// The number of bytes of the name.
+		uint16 nameLength;
+
+		// The spec bytes.
+		const uint8* specBytes;
+
+		// The number of spec bytes.
+		uint16 defBytes;
+
+		ShxShape()
+		{
+			number = 0;
+			name = nullptr;
+			nameLength = 0;
+			specBytes = nullptr;
+			defBytes = 0;
+		}
+	};
+
+	/*!
+	 \brief Read only access to the shapes of a SHX file. The file is mapped into memory and not
+	 copied. On first access an index is built once: the position of each record and, for unifonts
+	 and bigfonts, a table with the index of each shape number, for normal fonts the shape numbers
+	 in ascending order for binary search.
+
+	 After loading, the font may be read by several threads at once. Only one of them builds the
+	 index, the others wait for it.
+	 */
+	class ShxFont
+	{
+		public:
+
+			// The index of shape numbers, which do not exist.
+			static const uint32 kNotFound = 0xFFFFFFFF;
+
+			ShxFont();
+
+			/*!
+			 \brief Maps the SHX file and reads its file type.
+			 \throws jm::Exception, if the file cannot be read or has an unknown file type.
+			 */
+			void load(const jm::String &filename);
+
+			/*!
+			 \brief Uses the given file content. The data is not copied and must stay valid as long as
+			 the font is used.
+			 \throws jm::Exception, if the file type is unknown.
+			 */
+			void load(const uint8* data, size_t length);
+
+			/*!
+			 \brief Returns the file type.
+			 */
+			ShxFormat format() const;
+
+			/*!
+			 \brief Status whether the file is a Unicode font.
+			 */
+			bool isUnicode() const;
+
+			/*!
+			 \brief Returns the escape ranges of a bigfont.
+			 \throws jm::Exception, if the file is corrupt.
+			 */
+			const std::vector<EscapeRange>& escapeRanges() const;
+
+			/*!
+			 \brief Returns the number of shapes.
+			 \throws jm::Exception, if the file is corrupt.
+			 */
+			uint32 size() const;
+
+			/*!
+			 \brief Returns the index of the shape with the number or kNotFound.
+			 \throws jm::Exception, if the file is corrupt.
+			 */
+			uint32 find(uint16 number) const;
+
+			/*!
+			 \brief Returns the shape at the index in the order of the file.
+			 \throws jm::Exception, if the file is corrupt.
+			 */
+			ShxShape shape(uint32 index) const;
+
+			/*!
+			 \brief Returns the name of the shape at the index, decoded from Windows-1252.
+			 \throws jm::Exception, if the file is corrupt.
+			 */
+			jm::String name(uint32 index) const;
+
+		private:
+
+			/*!
+			 \brief The fixed fields of a shape.
+			 */
+			struct Header
+			{
+				// The shape number.
+				uint16 number;
+
+				// The number of bytes of the name.
+				uint16 nameLength;
+
+				// The number of bytes of the record.
+				uint16 length;
+
+				// The position of the record in the file.
+				uint32 offset;
+			};
+
+			// The mapped file, if it was loaded by name.
+			MappedFile mFile;
+
+			// The content of the file.
+			const uint8* mData;
+
+			// The number of bytes of the file.
+			size_t mSize;
+
+			// The file type.
+			ShxFormat mFormat;
+
+			// The shapes in the order of the file.
+			std::vector<Header> mHeaders;
+
+			// For unifonts and bigfonts the index of each shape number, for normal fonts the indices
+			// of the shapes ordered by number.
+			std::vector<uint32> mLookup;
+
+			// The escape ranges of a bigfont.
+			std::vector<EscapeRange> mEscapes;
+
+			// Status whether the index was built.
+			mutable std::atomic<bool> mIndexed;
+
+			// Locks the building of the index.
+			mutable std::mutex mMutex;
+
+			void index() const;
+
+			void build();
+
+			bool dense() const;
+
+			void readUnicode(size_t position);
+
+			void readNormal(size_t position);
+
+			void readBigfont(size_t position);
+
+			Header header(uint16 number, size_t offset, uint16 length) const;
+	};
+
+}
+
+#endif
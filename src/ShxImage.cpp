@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ShxImage.cpp
+// Application: Shape File Compiler
+// Purpose:     In-memory image of a SHX file
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#include "AtomicFile.h"
+#include "ShxImage.h"
+
+using namespace shpc;
+
+const char* shpc::filetype(ShxFormat format)
+{
+	switch(format)
+	{
+		case ShxFormat::kUnifont:
+			return "AutoCAD-86 unifont 1.0\r\n\x1A";
+
+		case ShxFormat::kShapes11:
+			return "AutoCAD-86 shapes 1.1\r\n\x1A";
+
+		case ShxFormat::kBigfont:
+			return "AutoCAD-86 bigfont 1.0\r\n\x1A";
+
+		case ShxFormat::kShapes10:
+			break;
+	}
+	return "AutoCAD-86 shapes 1.0\r\n\x1A";
+}
+
+bool shpc::wideSubshapes(ShxFormat format)
+{
+	return format == ShxFormat::kUnifont || format == ShxFormat::kBigfont;
+}
+
+ShxImage::ShxImage()
+{
+	mPosition = 0;
+}
+
+void ShxImage::allocate(uint32 size)
+{
+	mBuffer.assign(size, 0);
+	mPosition = 0;
+}
+
+void ShxImage::build(ShxFormat format,
+                     const ShapeTable &shapes,
+                     const std::vector<EscapeRange> &ranges)
+{
+	const char* type = filetype(format);
+	uint32 length = (uint32)std::strlen(type);
+
+	if(format == ShxFormat::kBigfont)
+	{
+		uint32 count = shapes.size();
+		uint32 index = length + 6 + 4 * (uint32)ranges.size();
+		allocate(index + 8 * count + shapes.arenaSize());
+		write((const uint8*)type, length);
+
+		// Write number of index entries, number of shapes and number of escape ranges
+		writeLE16((uint16)count);
+		writeLE16((uint16)count);
+		writeLE16((uint16)ranges.size());
+
+		// Write escape ranges
+		for(size_t a = 0; a < ranges.size(); a++)
+		{
+			writeLE16(ranges[a].first);
+			writeLE16(ranges[a].last);
+		}
+
+		// Write index. The records follow it in the same order.
+		uint32 offset = index + 8 * count;
+		for(uint32 a = 0; a < count; a++)
+		{
+			writeLE16(shapes.number(a));
+			writeLE16((uint16)shapes.recordLength(a));
+			writeLE32(offset);
+			offset += shapes.recordLength(a);
+		}
+
+		write(shapes.arena(), shapes.arenaSize());
+		return;
+	}
+
+	if(format == ShxFormat::kUnifont)
+	{
+		allocate(length + 2 + 4 * shapes.size() + shapes.arenaSize());
+		write((const uint8*)type, length);
+
+		// Write number of shapes
+		writeLE16((uint16)shapes.size());
+
+		// Write shapes
+		for(uint32 a = 0; a < shapes.size(); a++)
+		{
+			// Shape number
+			writeLE16(shapes.number(a));
+
+			// Buffer length
+			writeLE16(shapes.recordLength(a));
+
+			// Shape name and buffer
+			write(shapes.record(a), shapes.recordLength(a));
+		}
+		return;
+	}
+
+	allocate(length + 6 + 4 * shapes.size() + shapes.arenaSize() + 3);
+	write((const uint8*)type, length);
+
+	// Write lowest and highest shape number and the number of shapes
+	writeLE16(shapes.number(0));
+	writeLE16(shapes.number(shapes.size() - 1));
+	writeLE16((uint16)shapes.size());
+
+	// Write shape header
+	for(uint32 a = 0; a < shapes.size(); a++)
+	{
+		// shape number
+		writeLE16(shapes.number(a));
+
+		// buffer length
+		writeLE16(shapes.recordLength(a));
+	}
+
+	// Write shape data. The records of all shapes are stored one after the other in the arena.
+	write(shapes.arena(), shapes.arenaSize());
+
+	//Write End-Of-File
+	write((const uint8*)"EOF", 3);
+}
+
+void ShxImage::writeLE16(uint16 value)
+{
+	if(mPosition + 2 > mBuffer.size())throw jm::Exception("SHX image size exceeded.");
+	mBuffer[mPosition++] = (uint8)value;
+	mBuffer[mPosition++] = (uint8)(value >> 8);
+}
+
+void ShxImage::writeLE32(uint32 value)
+{
+	if(mPosition + 4 > mBuffer.size())throw jm::Exception("SHX image size exceeded.");
+	mBuffer[mPosition++] = (uint8)value;
+	mBuffer[mPosition++] = (uint8)(value >> 8);
+	mBuffer[mPosition++] = (uint8)(value >> 16);
+	mBuffer[mPosition++] = (uint8)(value >> 24);
+}
+
+void ShxImage::write(const uint8* data, uint32 length)
+{
+	if(mPosition + length > mBuffer.size())throw jm::Exception("SHX image size exceeded.");
+	if(length > 0)std::memcpy(mBuffer.data() + mPosition, data, length);
+	mPosition += length;
+}
+
+uint32 ShxImage::position() const
+{
+	return mPosition;
+}
+
+const std::vector<uint8>& ShxImage::data() const
+{
+	return mBuffer;
+}
+
+void ShxImage::save(const jm::String &filename) const
+{
+	if(mPosition != mBuffer.size())throw jm::Exception("SHX image incomplete.");
+
+	saveAtomic(filename, mBuffer.data(), mBuffer.size());
+}
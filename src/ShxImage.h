@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ShxImage.h
+// Application: Shape File Compiler
+// Purpose:     In-memory image of a SHX file
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_ShxImage_h
+#define shpc_ShxImage_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+#include "ShapeTable.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The file types of SHX files.
+	 */
+	enum class ShxFormat
+	{
+		kUnifont,
+		kShapes11,
+		kShapes10,
+		kBigfont
+	};
+
+	/*!
+	 \brief Returns the string, with which SHX files of the type begin.
+	 */
+	const char* filetype(ShxFormat format);
+
+	/*!
+	 \brief Status whether the subshape command (7) of the file type is followed by a shape number
+	 of two bytes. This is the case in unifonts and bigfonts.
+	 */
+	bool wideSubshapes(ShxFormat format);
+
+	/*!
+	 \brief A range of lead bytes of a bigfont. A lead byte in the range and the following byte
+	 form the code of a double byte character, e.g. 0x81 to 0x9F in Shift-JIS.
+	 */
+	struct EscapeRange
+	{
+		// The first lead byte.
+		uint8 first;
+
+		// The last lead byte.
+		uint8 last;
+	};
+
+	/*!
+	 \brief The complete content of a SHX file in memory. The size of the image is determined in
+	 advance, so that the buffer is allocated exactly once. The image is written to disk with a
+	 single call.
+	 */
+	class ShxImage
+	{
+		public:
+
+			ShxImage();
+
+			/*!
+			 \brief Allocates the image and resets the write position.
+			 \param size The exact size of the file in bytes.
+			 */
+			void allocate(uint32 size);
+
+			/*!
+			 \brief Allocates the image and writes the shapes as SHX file of the type. In Unicode
+			 fonts each record follows its shape number and length. Normal fonts have a table of all
+			 shape numbers and lengths followed by the records. Bigfonts have the escape ranges and
+			 an index of the shape numbers, lengths and file positions of the records, so that a
+			 shape is found by binary search. The shapes must be ordered by number.
+			 \param ranges The escape ranges of a bigfont. Ignored for other file types.
+			 */
+			void build(ShxFormat format,
+			           const ShapeTable &shapes,
+			           const std::vector<EscapeRange> &ranges = std::vector<EscapeRange>());
+
+			/*!
+			 \brief Writes a 16-bit number LE (little endian) encoded
+			 */
+			void writeLE16(uint16 value);
+
+			/*!
+			 \brief Writes a 32-bit number LE (little endian) encoded
+			 */
+			void writeLE32(uint32 value);
+
+			/*!
+			 \brief Writes the given bytes.
+			 */
+			void write(const uint8* data, uint32 length);
+
+			/*!
+			 \brief Returns the number of bytes written so far.
+			 */
+			uint32 position() const;
+
+			/*!
+			 \brief Returns the bytes of the image.
+			 */
+			const std::vector<uint8>& data() const;
+
+			/*!
+			 \brief Saves the image atomically with saveAtomic(), so other processes never see a
+			 partially written file.
+			 \throws jm::Exception, if the image is incomplete or cannot be written.
+			 */
+			void save(const jm::String &filename) const;
+
+		private:
+
+			// The content of the file.
+			std::vector<uint8> mBuffer;
+
+			// Write position in the buffer.
+			uint32 mPosition;
+	};
+
+}
+
+#endif
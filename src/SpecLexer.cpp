@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        SpecLexer.cpp
+// Application: Shape File Compiler
+// Purpose:     Lexer for the spec bytes of shape definitions
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SpecLexer.h"
+
+using namespace shpc;
+
+SpecLexer::SpecLexer(const uint8* data, uint32 length, const char* delimiters)
+{
+	mPosition = data;
+	mEnd = data + length;
+
+	for(uint32 a = 0; a < 256; a++)mDelimiter[a] = false;
+	while(*delimiters != 0)mDelimiter[(uint8)*delimiters++] = true;
+}
+
+bool SpecLexer::next(Token &token)
+{
+	// Skip delimiters, so that empty tokens are never returned
+	while(mPosition < mEnd && isDelimiter(*mPosition))mPosition++;
+	if(mPosition >= mEnd)return false;
+
+	token.data = mPosition;
+	while(mPosition < mEnd && !isDelimiter(*mPosition))mPosition++;
+	token.length = (uint32)(mPosition - token.data);
+	return true;
+}
+
+/*!
+ \brief Returns true for whitespace and control characters.
+ */
+static inline bool isSpace(uint8 c)
+{
+	return c <= ' ';
+}
+
+Token shpc::trim(const Token &token)
+{
+	Token result = token;
+	while(result.length > 0 && isSpace(result.data[0]))
+	{
+		result.data++;
+		result.length--;
+	}
+	while(result.length > 0 && isSpace(result.data[result.length - 1]))result.length--;
+	return result;
+}
+
+/*!
+ \brief Creates the exception for a token, which is not a valid number. The message is only built
+ in case of an error.
+ */
+static jm::Exception invalidNumber(const Token &token)
+{
+	jm::String text;
+	for(uint32 a = 0; a < token.length; a++)text.append(jm::Char(token.data[a]));
+	return jm::Exception("Invalid number \"" + text + "\".");
+}
+
+/*!
+ \brief Parses the token as hexadecimal number.
+ */
+static int32 parseHex(const Token &token)
+{
+	if(token.length == 0)throw invalidNumber(token);
+
+	int32 value = 0;
+	for(uint32 a = 0; a < token.length; a++)
+	{
+		uint8 c = token.data[a];
+		int32 digit;
+		if(c >= '0' && c <= '9')digit = c - '0';
+		else if(c >= 'a' && c <= 'f')digit = c - 'a' + 10;
+		else if(c >= 'A' && c <= 'F')digit = c - 'A' + 10;
+		else throw invalidNumber(token);
+		value = (value << 4) | digit;
+	}
+	return value;
+}
+
+/*!
+ \brief Parses the token as signed decimal number.
+ */
+static int32 parseDecimal(const Token &token)
+{
+	uint32 a = 0;
+	int32 sign = 1;
+	if(token.length > 0 && (token.data[0] == '-' || token.data[0] == '+'))
+	{
+		if(token.data[0] == '-')sign = -1;
+		a++;
+	}
+	if(a >= token.length)throw invalidNumber(token);
+
+	int32 value = 0;
+	for(; a < token.length; a++)
+	{
+		uint8 c = token.data[a];
+		if(c < '0' || c > '9')throw invalidNumber(token);
+		value = value * 10 + (c - '0');
+	}
+	return sign * value;
+}
+
+uint16 shpc::toNumber(const Token &token)
+{
+	if(token.length > 0 && token.data[0] == '0')return (uint16)parseHex(trim(token));
+	else return (uint16)parseDecimal(trim(token));
+}
+
+uint8 shpc::toSpecByte(const Token &token)
+{
+	Token t = trim(token);
+	int32 sign = 1;
+	if(t.length > 0 && t.data[0] == '-')
+	{
+		sign = -1;
+		t.data++;
+		t.length--;
+		t = trim(t);
+	}
+
+	int32 c = 0;
+	if(t.length > 0 && t.data[0] == '0')
+	{
+		c = parseHex(t);
+		if(sign < 0)c |= 0x80;// Note: Yes exactly this operation.
+	}
+	else
+	{
+		c = parseDecimal(t);
+		if(sign < 0)c *= -1;
+	}
+	return (uint8)c;
+}
+
+uint16 shpc::toSpecShort(const Token &token)
+{
+	return toNumber(trim(token));
+}
+
+std::ostream& shpc::operator<<(std::ostream &out, const Token &token)
+{
+	return out.write((const char*)token.data, token.length);
+}
@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        SpecLexer.h
+// Application: Shape File Compiler
+// Purpose:     Lexer for the spec bytes of shape definitions
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_SpecLexer_h
+#define shpc_SpecLexer_h
+
+#include <iostream>
+
+#include "core/Core.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief View on a token inside a line. No memory is owned by the token.
+	 */
+	struct Token
+	{
+		// Pointer to the first byte of the token.
+		const uint8* data;
+
+		// Number of bytes of the token.
+		uint32 length;
+
+		Token()
+		{
+			data = nullptr;
+			length = 0;
+		}
+	};
+
+	/*!
+	 \brief The lexer splits a line at the given delimiter characters. Like jm::StringTokenizer,
+	 empty tokens between two delimiters are skipped. The lexer works directly on the bytes of the
+	 line and does not allocate any memory.
+	 */
+	class SpecLexer
+	{
+		public:
+
+			/*!
+			 \brief Constructor
+			 \param data The bytes of the line.
+			 \param length The number of bytes.
+			 \param delimiters Zero terminated list of delimiter characters, e.g. ",()".
+			 */
+			SpecLexer(const uint8* data, uint32 length, const char* delimiters);
+
+			/*!
+			 \brief Determines the next token. Returns false, if there is no further token.
+			 */
+			bool next(Token &token);
+
+		private:
+
+			// Current position in the line.
+			const uint8* mPosition;
+
+			// End of the line.
+			const uint8* mEnd;
+
+			// Lookup table for the delimiters.
+			bool mDelimiter[256];
+
+			bool isDelimiter(uint8 c) const
+			{
+				return mDelimiter[c];
+			}
+	};
+
+	/*!
+	 \brief Removes leading and trailing whitespace from the token.
+	 */
+	Token trim(const Token &token);
+
+	/*!
+	 \brief Parses an unsigned number. If the token starts with 0, it is hexadecimal, otherwise
+	 decimal. The token is not trimmed before the check for the leading 0.
+	 */
+	uint16 toNumber(const Token &token);
+
+	/*!
+	 \brief This method parses a byte definition. A leading minus sign on a hexadecimal value sets
+	 the highest bit, a leading minus sign on a decimal value negates it.
+	 */
+	uint8 toSpecByte(const Token &token);
+
+	/*!
+	 \brief This method parses a two byte definition, i.e. a token with more than 4 characters.
+	 */
+	uint16 toSpecShort(const Token &token);
+
+	/*!
+	 \brief Writes the bytes of the token to the stream.
+	 */
+	std::ostream& operator<<(std::ostream &out, const Token &token);
+
+}
+
+#endif
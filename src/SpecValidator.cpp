@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        SpecValidator.cpp
+// Application: Shape File Compiler
+// Purpose:     Table driven validation of spec bytes
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SpecValidator.h"
+
+using namespace shpc;
+
+/*!
+ \brief Returns a failed result.
+ */
+static inline SpecResult failure(SpecError error, uint8 opcode, uint8 value = 0)
+{
+	SpecResult result;
+	result.error = error;
+	result.opcode = opcode;
+	result.value = value;
+	return result;
+}
+
+/*!
+ \brief Returns the index of the first byte, which breaks its rule, or count, if all are valid.
+ */
+static inline uint32 firstInvalid(const uint8* bytes, const OperandRule* rules, uint32 count)
+{
+	uint32 a = 0;
+	while(a < count && (bytes[a] & rules[a].mask) != rules[a].invalid)a++;
+	return a;
+}
+
+template<bool kUnicode>
+SpecResult shpc::validateSpec(const uint8* bytes, uint32 length)
+{
+	const OpcodeInfo* table = OpcodeTable<kUnicode>::kOpcodes;
+	const uint32 last = length - 1;
+
+	uint32 a = 0;
+	int32 stack = 0;
+	while(a < length)
+	{
+		uint8 code = bytes[a];
+
+		// Vectors are the most frequent bytes. Only a length of 0 (0x0F) is in the table.
+		if(code > 0x0F)
+		{
+			a++;
+			continue;
+		}
+
+		const OpcodeInfo &info = table[code];
+
+		if(info.invalid)return failure(SpecError::kZeroVector, code);
+		if(info.last && a != last)return failure(SpecError::kEndBeforeEnd, code);
+		if(info.reach > 0 && a + info.reach >= last)return failure(SpecError::kIncomplete, code);
+
+		stack += info.stack;
+		if(stack > 4)return failure(SpecError::kTooManyPush, code);
+		if(stack < 0)return failure(SpecError::kTooManyPop, code);
+
+		const uint8* operands = bytes + a + 1;
+		uint32 b = firstInvalid(operands, info.rules, info.operands);
+		if(b < info.operands)return failure(SpecError::kInvalidValue, code, operands[b]);
+		if(info.pair > 0 && (operands[info.pair - 1] | operands[info.pair]) == 0)
+			return failure(SpecError::kInvalidValue, code, 0);
+		a += info.operands;
+
+		// Lists of (dx,dy) or (dx,dy,bulge) terminated by (0,0)
+		if(info.entry > 0)
+		{
+			while(true)
+			{
+				if(a + 2 >= last)return failure(SpecError::kIncomplete, code);
+				uint8 dx = bytes[a + 1];
+				uint8 dy = bytes[a + 2];
+				a += 2;
+				if((dx | dy) == 0)break;
+
+				uint32 rest = info.entry - 2u;
+				if(rest == 0)continue;
+				if(a + rest >= last)return failure(SpecError::kIncomplete, code);
+				b = firstInvalid(bytes + a + 1, info.rules + 2, rest);
+				if(b < rest)return failure(SpecError::kInvalidValue, code, bytes[a + 1 + b]);
+				a += rest;
+			}
+		}
+
+		a++;
+	}
+
+	return failure(SpecError::kNone, 0);
+}
+
+template SpecResult shpc::validateSpec<false>(const uint8* bytes, uint32 length);
+template SpecResult shpc::validateSpec<true>(const uint8* bytes, uint32 length);
+
+SpecResult shpc::validateFontInfo(const uint8* bytes, uint32 length, bool unicode)
+{
+	// Modes: 0 = horizontal only, 2 = horizontal and vertical
+	if(length > 2 && bytes[2] != 0 && bytes[2] != 2)
+		return failure(SpecError::kInvalidFontInfo, 0, bytes[2]);
+
+	if(unicode)
+	{
+		// Encoding: 0 = Unicode, 1 = packed multibyte, 2 = shape file
+		if(length > 3 && bytes[3] > 2)return failure(SpecError::kInvalidFontInfo, 0, bytes[3]);
+
+		// Embedding: 0 = allowed, 1 = not allowed, 2 = read-only
+		if(length > 4 && bytes[4] > 2)return failure(SpecError::kInvalidFontInfo, 0, bytes[4]);
+	}
+
+	return failure(SpecError::kNone, 0);
+}
+
+jm::String shpc::specErrorMessage(const SpecResult &result, bool unicode)
+{
+	const OpcodeInfo &info = unicode
+	                         ? OpcodeTable<true>::kOpcodes[result.opcode & 0x0F]
+	                         : OpcodeTable<false>::kOpcodes[result.opcode & 0x0F];
+
+	jm::String command = jm::String(info.name)
+	                     + " (" + jm::String::valueOf((int64)result.opcode) + ")";
+	jm::String value = jm::String::valueOf((int64)result.value);
+
+	switch(result.error)
+	{
+		case SpecError::kNone:
+			return jm::kEmptyString;
+
+		case SpecError::kEndBeforeEnd:
+			return command + " before end of shape found.";
+
+		case SpecError::kIncomplete:
+			if(result.opcode == 14)return "No command after " + command + ".";
+			return command + " not complete.";
+
+		case SpecError::kTooManyPush:
+		case SpecError::kTooManyPop:
+			return "Too many " + command + ".";
+
+		case SpecError::kZeroVector:
+			return "Vector length is zero (00).";
+
+		case SpecError::kInvalidValue:
+			return "Invalid value " + value + " in " + command + ".";
+
+		case SpecError::kInvalidFontInfo:
+			return "Invalid value " + value + " in font information.";
+	}
+
+	return jm::kEmptyString;
+}
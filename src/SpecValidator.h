@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        SpecValidator.h
+// Application: Shape File Compiler
+// Purpose:     Table driven validation of spec bytes
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_SpecValidator_h
+#define shpc_SpecValidator_h
+
+#include "core/Core.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief Rule for the value of an operand byte. A byte is invalid, if (byte & mask) == invalid.
+	 */
+	struct OperandRule
+	{
+		uint8 mask;
+		uint8 invalid;
+	};
+
+	// Every value is allowed.
+	constexpr OperandRule kAnyValue = {0x00, 0x01};
+
+	// The value must not be 0, e.g. a scale factor, a radius or a shape number.
+	constexpr OperandRule kNonZero = {0xFF, 0x00};
+
+	// The count of octants in (-)0SC must be 0 to 7, i.e. bit 3 must not be set.
+	constexpr OperandRule kOctants = {0x08, 0x08};
+
+	// The bulge must be between -127 and 127, i.e. -128 is not allowed.
+	constexpr OperandRule kBulge = {0xFF, 0x80};
+
+	/*!
+	 \brief Descriptor of an opcode of the spec bytes.
+	 */
+	struct OpcodeInfo
+	{
+		// The name of the command in messages.
+		const char* name;
+
+		// The number of operand bytes, which follow the opcode.
+		uint8 operands;
+
+		// The number of bytes, which must follow the opcode before the final 0. This is more than
+		// the operands for the Do-Next-Command (14), which needs a following command.
+		uint8 reach;
+
+		// The number of bytes of an entry of a list terminated by (0,0) or 0, if the command has no
+		// list.
+		uint8 entry;
+
+		// The change of the position stack.
+		int8 stack;
+
+		// Status whether the command may only be the last byte of a shape.
+		bool last;
+
+		// Status whether the byte is never valid.
+		bool invalid;
+
+		// The 1-based index of an operand, which forms a 2-byte value with the next operand, that
+		// must not be 0. 0, if there is no such value.
+		uint8 pair;
+
+		// The rules for the operands, resp. for the bytes of a list entry.
+		OperandRule rules[5];
+	};
+
+	/*!
+	 \brief The table of the opcodes 0 to 14 and the byte 0x0F, which is a vector of length 0. All
+	 other bytes are vectors. The variants differ in the Subshape-Command (7), whose shape number has
+	 two bytes in Unicode fonts.
+	 */
+	template<bool kUnicode>
+	struct OpcodeTable
+	{
+		static constexpr OpcodeInfo kOpcodes[16] =
+		{
+			{"End-Of-Shape-Command", 0, 0, 0, 0, true, false, 0, {}},
+			{"Pen-Down-Command", 0, 0, 0, 0, false, false, 0, {}},
+			{"Pen-Up-Command", 0, 0, 0, 0, false, false, 0, {}},
+			{"Scale-Down-Command", 1, 1, 0, 0, false, false, 0, {kNonZero}},
+			{"Scale-Up-Command", 1, 1, 0, 0, false, false, 0, {kNonZero}},
+			{"Push-Commands", 0, 0, 0, 1, false, false, 0, {}},
+			{"Pop-Commands", 0, 0, 0, -1, false, false, 0, {}},
+			{
+				"Subshape-Command", kUnicode ? 2 : 1, kUnicode ? 2 : 1, 0, 0, false, false,
+				kUnicode ? 1 : 0, {kUnicode ? kAnyValue : kNonZero, kAnyValue}
+			},
+			{"Line-To-Command", 2, 2, 0, 0, false, false, 0, {kAnyValue, kAnyValue}},
+			{"Multi-Line-To-Command", 0, 0, 2, 0, false, false, 0, {kAnyValue, kAnyValue}},
+			{"Octant-Arc-Command", 2, 2, 0, 0, false, false, 0, {kNonZero, kOctants}},
+			{
+				"Fractional-Arc-Command", 5, 5, 0, 0, false, false, 3,
+				{kAnyValue, kAnyValue, kAnyValue, kAnyValue, kOctants}
+			},
+			{"Arc-To-Command", 3, 3, 0, 0, false, false, 0, {kAnyValue, kAnyValue, kBulge}},
+			{"Multi-Arc-To-Command", 0, 0, 3, 0, false, false, 0, {kAnyValue, kAnyValue, kBulge}},
+			{"Do-Next-Command", 0, 1, 0, 0, false, false, 0, {}},
+			{"Vector", 0, 0, 0, 0, false, true, 0, {}}
+		};
+	};
+
+	template<bool kUnicode>
+	constexpr OpcodeInfo OpcodeTable<kUnicode>::kOpcodes[16];
+
+	/*!
+	 \brief Returns the number of bytes of the command at the position, i.e. the opcode with its
+	 operands or its list including the terminating (0,0). The spec bytes must be valid.
+	 */
+	template<bool kUnicode>
+	inline uint32 commandSize(const uint8* bytes, uint32 position)
+	{
+		uint8 code = bytes[position];
+		if(code > 0x0F)return 1;
+
+		const OpcodeInfo &info = OpcodeTable<kUnicode>::kOpcodes[code];
+		uint32 size = 1u + info.operands;
+		if(info.entry > 0)
+		{
+			const uint8* entry = bytes + position + size;
+			while(entry[0] != 0 || entry[1] != 0)entry += info.entry;
+			size = (uint32)(entry + 2 - (bytes + position));
+		}
+		return size;
+	}
+
+	/*!
+	 \brief Returns the number of bytes of the command at the position.
+	 */
+	inline uint32 commandSize(const uint8* bytes, uint32 position, bool unicode)
+	{
+		return unicode ? commandSize<true>(bytes, position) : commandSize<false>(bytes, position);
+	}
+
+	/*!
+	 \brief Errors in the spec bytes of a shape.
+	 */
+	enum class SpecError : uint8
+	{
+		kNone,
+		kEndBeforeEnd,
+		kIncomplete,
+		kTooManyPush,
+		kTooManyPop,
+		kZeroVector,
+		kInvalidValue,
+		kInvalidFontInfo
+	};
+
+	/*!
+	 \brief Result of the validation of the spec bytes of a shape.
+	 */
+	struct SpecResult
+	{
+		// The error or kNone.
+		SpecError error;
+
+		// The opcode of the faulty command.
+		uint8 opcode;
+
+		// The invalid value.
+		uint8 value;
+	};
+
+	/*!
+	 \brief Validates the spec bytes of a shape. The loop is driven by the opcode table and does not
+	 allocate memory, so the message is only created on failure.
+	 \param bytes The spec bytes.
+	 \param length The number of spec bytes. Must be at least 1.
+	 */
+	template<bool kUnicode>
+	SpecResult validateSpec(const uint8* bytes, uint32 length);
+
+	/*!
+	 \brief Validates the font information in shape 0 of a font. These bytes are not commands, but
+	 the height above and below the baseline, the modes and in Unicode fonts the encoding and the
+	 embedding type.
+	 */
+	SpecResult validateFontInfo(const uint8* bytes, uint32 length, bool unicode);
+
+	/*!
+	 \brief Returns the message for the result of a validation.
+	 */
+	jm::String specErrorMessage(const SpecResult &result, bool unicode);
+
+}
+
+#endif
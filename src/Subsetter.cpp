@@ -0,0 +1,398 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Subsetter.cpp
+// Application: Shape File Compiler
+// Purpose:     Subsets of fonts
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include <cstdio>
+#include <string>
+
+#include "MappedFile.h"
+#include "Subsetter.h"
+
+using namespace shpc;
+
+// The Unicode characters of the bytes 0x80 to 0x9F in Windows-1252. 0 if the byte is undefined.
+static const uint16 kWindows1252[32] =
+{
+	0x20AC, 0, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+	0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0, 0x017D, 0,
+	0, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+	0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0, 0x017E, 0x0178
+};
+
+/*!
+ \brief Encodes the Unicode character in Windows-1252, the encoding of normal fonts.
+ \return false, if Windows-1252 has no such character.
+ */
+static bool encodeWindows1252(uint32 code, uint16 &number)
+{
+	if(code < 0x80 || (code >= 0xA0 && code <= 0xFF))
+	{
+		number = (uint16)code;
+		return true;
+	}
+	for(uint32 a = 0; a < 32; a++)
+	{
+		if(kWindows1252[a] != 0 && kWindows1252[a] == code)
+		{
+			number = (uint16)(0x80 + a);
+			return true;
+		}
+	}
+	return false;
+}
+
+/*!
+ \brief Reads a shape number of a list: decimal, or hexadecimal with the prefix "0x" or "U+".
+ \return false, if there is no valid number at the position.
+ */
+static bool parseNumber(const std::string &list, size_t &position, uint16 &number)
+{
+	uint32 base = 10;
+	if(list.compare(position, 2, "0x") == 0 || list.compare(position, 2, "0X") == 0
+	   || list.compare(position, 2, "U+") == 0 || list.compare(position, 2, "u+") == 0)
+	{
+		base = 16;
+		position += 2;
+	}
+
+	uint32 value = 0;
+	size_t start = position;
+	while(position < list.size())
+	{
+		char c = list[position];
+		uint32 digit;
+		if(c >= '0' && c <= '9')digit = (uint32)(c - '0');
+		else if(base == 16 && c >= 'a' && c <= 'f')digit = (uint32)(c - 'a' + 10);
+		else if(base == 16 && c >= 'A' && c <= 'F')digit = (uint32)(c - 'A' + 10);
+		else break;
+
+		value = value * base + digit;
+		if(value > 0xFFFF)return false;
+		position++;
+	}
+
+	number = (uint16)value;
+	return position > start;
+}
+
+Subsetter::Subsetter()
+{
+	mVerbose = false;
+	mPool = nullptr;
+	mSelected.assign(0x10000, 0);
+	mCharacters.assign(0x10000, 0);
+	mMissing = 0;
+}
+
+void Subsetter::setVerbose(bool verbose)
+{
+	mVerbose = verbose;
+}
+
+void Subsetter::setThreadPool(ThreadPool* pool)
+{
+	mPool = pool;
+}
+
+void Subsetter::select(uint16 first, uint16 last)
+{
+	for(uint32 a = first; a <= last; a++)mSelected[a] = 1;
+}
+
+void Subsetter::select(const jm::String &list)
+{
+	jm::ByteArray bytes = list.toCString();
+	std::string text(bytes.constData(), (size_t)bytes.size());
+
+	size_t position = 0;
+	while(position < text.size())
+	{
+		if(text[position] == ',' || text[position] == ' ')
+		{
+			position++;
+			continue;
+		}
+
+		uint16 first;
+		if(!parseNumber(text, position, first))
+			throw jm::Exception("Invalid shape number in list: " + list);
+
+		uint16 last = first;
+		if(position < text.size() && text[position] == '-')
+		{
+			position++;
+			if(!parseNumber(text, position, last))
+				throw jm::Exception("Invalid shape number in list: " + list);
+		}
+
+		if(last < first)throw jm::Exception("Invalid range in list: " + list);
+		if(position < text.size() && text[position] != ',' && text[position] != ' ')
+			throw jm::Exception("Invalid shape number in list: " + list);
+
+		select(first, last);
+	}
+}
+
+void Subsetter::selectText(const uint8* text, size_t length)
+{
+	size_t position = 0;
+	while(position < length)
+	{
+		uint8 lead = text[position];
+		uint32 code = lead;
+		uint32 count = 0;
+
+		if(lead >= 0xC2 && lead <= 0xDF)
+		{
+			code = lead & 0x1F;
+			count = 1;
+		}
+		else if(lead >= 0xE0 && lead <= 0xEF)
+		{
+			code = lead & 0x0F;
+			count = 2;
+		}
+		else if(lead >= 0xF0 && lead <= 0xF4)
+		{
+			code = lead & 0x07;
+			count = 3;
+		}
+
+		// The continuation bytes
+		bool valid = position + count < length;
+		for(uint32 a = 1; valid && a <= count; a++)
+		{
+			uint8 next = text[position + a];
+			if((next & 0xC0) != 0x80)valid = false;
+			else code = (code << 6) | (next & 0x3F);
+		}
+
+		// Invalid bytes are taken as Windows-1252, e.g. of a text written by an old editor.
+		if(!valid)
+		{
+			code = lead;
+			if(lead >= 0x80 && lead <= 0x9F && kWindows1252[lead - 0x80] != 0)
+				code = kWindows1252[lead - 0x80];
+			count = 0;
+		}
+
+		if(code <= 0xFFFF)mCharacters[code] = 1;
+		position += 1 + count;
+	}
+}
+
+void Subsetter::selectTextFile(const jm::String &filename)
+{
+	MappedFile file;
+	file.open(filename);
+	selectText(file.data(), file.size());
+}
+
+bool Subsetter::run(const jm::String &filename)
+{
+	try
+	{
+		process(filename);
+	}
+	catch(jm::Exception &e)
+	{
+		report(Severity::kError, e.errorMessage());
+		mImage.allocate(0);
+		return false;
+	}
+	return true;
+}
+
+const ShxImage& Subsetter::image() const
+{
+	return mImage;
+}
+
+const ShapeTable& Subsetter::shapes() const
+{
+	return mShapes;
+}
+
+bool Subsetter::isUnicode() const
+{
+	return mFont.format() == ShxFormat::kUnifont;
+}
+
+uint32 Subsetter::missing() const
+{
+	return mMissing;
+}
+
+const std::vector<Diagnostic>& Subsetter::diagnostics() const
+{
+	return mDiagnostics;
+}
+
+void Subsetter::report(Severity severity, const jm::String &message)
+{
+	mDiagnostics.push_back(Diagnostic(severity, 0, message));
+}
+
+/*!
+ \brief This method controls the subsetting as a whole.
+ */
+void Subsetter::process(const jm::String &filename)
+{
+	mShapes.clear();
+	mMissing = 0;
+	mDiagnostics.clear();
+
+	mFont.setVerbose(mVerbose);
+	mFont.setThreadPool(mPool);
+	bool success = mFont.load(filename);
+	const std::vector<Diagnostic> &diagnostics = mFont.diagnostics();
+	mDiagnostics.insert(mDiagnostics.end(), diagnostics.begin(), diagnostics.end());
+	if(!success)throw jm::Exception("Cannot read \"" + filename + "\".");
+
+	const ShapeTable &font = mFont.shapes();
+	if(font.size() == 0)throw jm::Exception("No shapes found.");
+
+	mGraph.build(font, wideSubshapes(mFont.format()));
+	selectCharacters();
+	collect();
+
+	if(mShapes.size() == 0)throw jm::Exception("No selected shape found in \"" + filename + "\".");
+	mImage.build(mFont.format(), mShapes, mFont.escapeRanges());
+
+	report(Severity::kInfo, jm::String::valueOf((int64)mShapes.size())
+	       + " of "
+	       + jm::String::valueOf((int64)font.size())
+	       + " Shapes kept, "
+	       + jm::String::valueOf((int64)mMissing)
+	       + " selected shapes not found.");
+}
+
+/*!
+ \brief Selects the shapes of the characters of the texts. The shape numbers of unifonts are the
+ Unicode characters, the shape numbers of normal fonts are the bytes of Windows-1252. The
+ encoding of the double byte numbers of a bigfont is not known, so text cannot be selected there.
+ */
+void Subsetter::selectCharacters()
+{
+	bool text = false;
+	for(uint32 a = 0; a < mCharacters.size() && !text; a++)text = mCharacters[a] != 0;
+	if(!text)return;
+
+	ShxFormat format = mFont.format();
+	if(format == ShxFormat::kBigfont)
+		throw jm::Exception("Text cannot be selected in a bigfont, because the encoding of its "
+		                    "characters is unknown. Select the shape numbers instead.");
+
+	for(uint32 a = 0; a < mCharacters.size(); a++)
+	{
+		if(mCharacters[a] == 0)continue;
+
+		uint16 number = (uint16)a;
+		if(format == ShxFormat::kUnifont || encodeWindows1252(a, number))mSelected[number] = 1;
+		else
+		{
+			mMissing++;
+			if(mVerbose)
+			{
+				char code[16];
+				std::snprintf(code, sizeof(code), "U+%04X", a);
+				report(Severity::kInfo, "Character " + jm::String(code) + " is not in Windows-1252.");
+			}
+		}
+	}
+}
+
+/*!
+ \brief Copies the selected shapes and all shapes they reference directly or indirectly into the
+ subset. The references are followed by a depth-first search, in which each shape is visited once.
+ */
+void Subsetter::collect()
+{
+	const ShapeTable &font = mFont.shapes();
+	std::vector<uint8> kept(font.size(), 0);
+	std::vector<uint32> stack;
+
+	// The font information is always needed.
+	uint32 info = mGraph.find(0);
+	if(info != ShapeGraph::kNoShape)
+	{
+		kept[info] = 1;
+		stack.push_back(info);
+	}
+
+	for(uint32 a = 0; a < mSelected.size(); a++)
+	{
+		if(mSelected[a] == 0)continue;
+
+		uint32 index = mGraph.find((uint16)a);
+		if(index == ShapeGraph::kNoShape)
+		{
+			mMissing++;
+			if(mVerbose)
+				report(Severity::kInfo, "Shape " + jm::String::valueOf((int64)a) + " not found.");
+		}
+		else if(kept[index] == 0)
+		{
+			kept[index] = 1;
+			stack.push_back(index);
+		}
+	}
+
+	uint32 arena = 0;
+	while(!stack.empty())
+	{
+		uint32 index = stack.back();
+		stack.pop_back();
+		arena += font.recordLength(index);
+
+		for(uint32 a = 0; a < mGraph.referenceCount(index); a++)
+		{
+			uint32 target = mGraph.reference(index, a);
+			if(kept[target] == 0)
+			{
+				kept[target] = 1;
+				stack.push_back(target);
+			}
+		}
+	}
+
+	// The subset keeps the order of the font.
+	mShapes.reserve(arena);
+	for(uint32 a = 0; a < font.size(); a++)
+	{
+		if(kept[a] == 0)continue;
+
+		const uint8* bytes = font.buffer(a);
+		uint32 index = mShapes.add(font.number(a),
+		                           font.defBytes(a),
+		                           font.encodedName(a),
+		                           font.nameLength(a));
+		for(uint16 b = 0; b < font.defBytes(a); b++)mShapes.append(index, bytes[b]);
+	}
+}
@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Subsetter.h
+// Application: Shape File Compiler
+// Purpose:     Subsets of fonts
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef shpc_Subsetter_h
+#define shpc_Subsetter_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+#include "Compiler.h"
+#include "FontFile.h"
+#include "ShapeGraph.h"
+#include "ShapeTable.h"
+#include "ShxImage.h"
+#include "ThreadPool.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The subsetter writes a font, which contains only the shapes needed for a given set of
+	 characters, e.g. for rendering nodes, which draw only a few hundred characters of a large
+	 unifont. The shapes are selected by their number, i.e. the code of the character. The shapes
+	 referenced as subshapes by the selected shapes are kept as well, also if they are referenced
+	 indirectly. Shape 0 with the font information is always kept.
+
+	 The input may be a SHP file, which is compiled, or a SHX file.
+	 */
+	class Subsetter
+	{
+		public:
+
+			Subsetter();
+
+			/*!
+			 \brief Status whether detailed information is added to the diagnostics.
+			 */
+			void setVerbose(bool verbose);
+
+			/*!
+			 \brief Sets the thread pool, on which large SHP files are compiled. If nullptr
+			 (default), the file is compiled in the calling thread.
+			 */
+			void setThreadPool(ThreadPool* pool);
+
+			/*!
+			 \brief Selects the shapes with the numbers from first to last.
+			 */
+			void select(uint16 first, uint16 last);
+
+			/*!
+			 \brief Selects the shapes of a list of numbers and ranges separated by commas, e.g.
+			 "32-126,0xB0,U+2300-U+23FF". Numbers are decimal, or hexadecimal with the prefix "0x" or
+			 "U+".
+			 \throws jm::Exception, if the list is malformed.
+			 */
+			void select(const jm::String &list);
+
+			/*!
+			 \brief Selects the shapes of all characters of a text encoded in UTF-8. Bytes, which
+			 are no valid UTF-8, are taken as characters of Windows-1252. Characters outside the
+			 Basic Multilingual Plane are ignored, because they have no shape number. The characters
+			 are encoded like the font, when it is read: in unifonts the shape number is the Unicode
+			 character, in normal fonts the byte of Windows-1252. Bigfonts cannot be subset by text.
+			 */
+			void selectText(const uint8* text, size_t length);
+
+			/*!
+			 \brief Selects the shapes of all characters of a text file encoded in UTF-8.
+			 \throws jm::Exception, if the file cannot be read.
+			 */
+			void selectTextFile(const jm::String &filename);
+
+			/*!
+			 \brief Reads the font and writes the SHX image with the selected shapes.
+			 \return true on success. On failure the diagnostics contain at least one error.
+			 */
+			bool run(const jm::String &filename);
+
+			/*!
+			 \brief Returns the SHX file with the subset. Only valid after a successful run.
+			 */
+			const ShxImage& image() const;
+
+			/*!
+			 \brief Returns the shapes of the subset.
+			 */
+			const ShapeTable& shapes() const;
+
+			/*!
+			 \brief Returns true, if the font is in Unicode format.
+			 */
+			bool isUnicode() const;
+
+			/*!
+			 \brief Returns the number of selected shapes, which the font does not contain.
+			 */
+			uint32 missing() const;
+
+			/*!
+			 \brief Returns all messages. Messages of the compilation of a SHP file start with the
+			 name of the file.
+			 */
+			const std::vector<Diagnostic>& diagnostics() const;
+
+		private:
+
+			// Status whether detailed information is reported.
+			bool mVerbose;
+
+			// The pool for the compilation or nullptr.
+			ThreadPool* mPool;
+
+			// For each shape number, whether it is selected.
+			std::vector<uint8> mSelected;
+
+			// For each Unicode character of the texts, whether it is selected.
+			std::vector<uint8> mCharacters;
+
+			// The font.
+			FontFile mFont;
+
+			// The subshape references of the font.
+			ShapeGraph mGraph;
+
+			// The shapes of the subset.
+			ShapeTable mShapes;
+
+			// The SHX file with the subset.
+			ShxImage mImage;
+
+			// The number of selected shapes, which the font does not contain.
+			uint32 mMissing;
+
+			// The messages.
+			std::vector<Diagnostic> mDiagnostics;
+
+			void process(const jm::String &filename);
+
+			void selectCharacters();
+
+			void collect();
+
+			void report(Severity severity, const jm::String &message);
+	};
+
+}
+
+#endif
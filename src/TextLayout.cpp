@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        TextLayout.cpp
+// Application: Shape File Compiler
+// Purpose:     Layout of texts
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include "TextLayout.h"
+
+using namespace shpc;
+
+TextLayout::TextLayout(GlyphCache &cache): mCache(cache)
+{
+}
+
+uint32 TextLayout::layout(const uint16* text,
+                          uint32 length,
+                          const TextStyle &style,
+                          Outline &outline)
+{
+	outline.clear();
+
+	// Scaling with width factor and slant, then rotation and translation
+	float scale = style.height / mCache.above();
+	float slant = (float)std::tan(style.oblique * 3.14159265358979323846 / 180);
+	Transform base = Transform::translation(style.x, style.y)
+	                 .multiply(Transform::rotation(style.rotation))
+	                 .multiply(Transform(scale * style.widthFactor, 0, scale * slant, scale, 0, 0));
+
+	// The position of the pen in the units of the shapes
+	float x = 0;
+	float y = 0;
+	uint32 count = 0;
+
+	for(uint32 a = 0; a < length; a++)
+	{
+		const Outline* glyph = mCache.find(text[a]);
+		if(glyph == nullptr)continue;
+
+		outline.append(*glyph, base.multiply(Transform::translation(x, y)));
+		x += glyph->advance().x;
+		y += glyph->advance().y;
+		count++;
+	}
+
+	Point end = base.map(x, y);
+	outline.setAdvance(end.x, end.y);
+	return count;
+}
+
+uint32 TextLayout::layout(const jm::String &text, const TextStyle &style, Outline &outline)
+{
+	mText.resize(text.size());
+	for(uint32 a = 0; a < text.size(); a++)mText[a] = text.charAt(a).unicode();
+	return layout(mText.data(), (uint32)mText.size(), style, outline);
+}
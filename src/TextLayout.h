@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        TextLayout.h
+// Application: Shape File Compiler
+// Purpose:     Layout of texts
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_TextLayout_h
+#define shpc_TextLayout_h
+
+#include <vector>
+
+#include "core/Core.h"
+
+#include "GlyphCache.h"
+#include "Outline.h"
+#include "Transform.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The parameters of a text like in CAD applications.
+	 */
+	struct TextStyle
+	{
+		// The height of the capital letters.
+		float height;
+
+		// The factor for the width of the characters.
+		float widthFactor;
+
+		// The slant of the characters in degrees from the vertical, positive to the right.
+		float oblique;
+
+		// The counterclockwise rotation of the text in degrees.
+		float rotation;
+
+		// The insertion point of the text.
+		float x;
+		float y;
+
+		TextStyle()
+		{
+			height = 1;
+			widthFactor = 1;
+			oblique = 0;
+			rotation = 0;
+			x = 0;
+			y = 0;
+		}
+	};
+
+	/*!
+	 \brief The layout places the shapes of the characters of a text one after another. Each shape
+	 starts at the position, where the pen stopped after the previous shape. The characters are the
+	 shape numbers, i.e. character codes in normal fonts and Unicode code points in Unicode fonts.
+	 Characters without shape are left out.
+
+	 The outlines are taken from the glyph cache and are transformed in one batch per shape. The
+	 shapes are scaled, so that the height above the baseline from the font information becomes the
+	 height of the text.
+	 */
+	class TextLayout
+	{
+		public:
+
+			/*!
+			 \brief Constructor. The cache must exist during the lifetime of the layout.
+			 */
+			TextLayout(GlyphCache &cache);
+
+			/*!
+			 \brief Lays out the characters. The outline is cleared before. It gets the transformed
+			 polylines of all characters and as advance the point, where the next text would start.
+			 \return The number of characters with shape.
+			 */
+			uint32 layout(const uint16* text, uint32 length, const TextStyle &style, Outline &outline);
+
+			/*!
+			 \brief Lays out the text.
+			 */
+			uint32 layout(const jm::String &text, const TextStyle &style, Outline &outline);
+
+		private:
+
+			// The outlines of the shapes.
+			GlyphCache &mCache;
+
+			// The characters of the last text.
+			std::vector<uint16> mText;
+	};
+
+}
+
+#endif
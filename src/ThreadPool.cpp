@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ThreadPool.cpp
+// Application: Shape File Compiler
+// Purpose:     Work-stealing thread pool
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool.h"
+
+using namespace shpc;
+
+TaskGroup::TaskGroup()
+{
+	mPending = 0;
+}
+
+/*!
+ \brief The pool, the current thread is working for. nullptr, if it is not a worker.
+ */
+static thread_local ThreadPool* tPool = nullptr;
+
+/*!
+ \brief The index of the current worker in its pool.
+ */
+static thread_local uint32 tIndex = 0;
+
+ThreadPool::ThreadPool(uint32 threads): mQueued(0), mNext(0)
+{
+	if(threads == 0)threads = std::thread::hardware_concurrency();
+	if(threads == 0)threads = 1;
+
+	mUnfinished = 0;
+	mStop = false;
+
+	for(uint32 a = 0; a < threads; a++)mQueues.push_back(new Queue());
+	for(uint32 a = 0; a < threads; a++)mThreads.push_back(std::thread(&ThreadPool::work, this, a));
+}
+
+ThreadPool::~ThreadPool()
+{
+	wait();
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStop = true;
+	}
+	mWakeup.notify_all();
+
+	for(size_t a = 0; a < mThreads.size(); a++)mThreads[a].join();
+	for(size_t a = 0; a < mQueues.size(); a++)delete mQueues[a];
+}
+
+uint32 ThreadPool::size() const
+{
+	return (uint32)mThreads.size();
+}
+
+void ThreadPool::submit(const std::function<void()> &task, TaskGroup* group)
+{
+	// Workers keep their own tasks local, all others are distributed.
+	uint32 index;
+	if(tPool == this)index = tIndex;
+	else index = mNext++ % (uint32)mQueues.size();
+
+	Task t;
+	t.function = task;
+	t.group = group;
+
+	// The counter is raised before the task is visible, so a worker, which takes the task at once,
+	// never decrements it below 0.
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mUnfinished++;
+		mQueued++;
+		if(group != nullptr)group->mPending++;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mQueues[index]->mutex);
+		mQueues[index]->tasks.push_back(t);
+	}
+	mWakeup.notify_one();
+	mDone.notify_all();
+}
+
+/*!
+ \brief Takes the next task. First from the back of the own queue, then from the front of the other
+ queues.
+ */
+bool ThreadPool::pop(uint32 index, Task &task)
+{
+	uint32 count = (uint32)mQueues.size();
+
+	for(uint32 a = 0; a < count; a++)
+	{
+		Queue* queue = mQueues[(index + a) % count];
+		std::lock_guard<std::mutex> lock(queue->mutex);
+		if(queue->tasks.empty())continue;
+
+		if(a == 0 && tPool == this)
+		{
+			task = queue->tasks.back();
+			queue->tasks.pop_back();
+		}
+		else
+		{
+			task = queue->tasks.front();
+			queue->tasks.pop_front();
+		}
+		mQueued--;
+		return true;
+	}
+	return false;
+}
+
+/*!
+ \brief Executes the task and marks it as finished.
+ */
+void ThreadPool::execute(Task &task)
+{
+	task.function();
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mUnfinished--;
+		if(task.group != nullptr)task.group->mPending--;
+	}
+	mDone.notify_all();
+}
+
+/*!
+ \brief The loop of a worker thread.
+ */
+void ThreadPool::work(uint32 index)
+{
+	tPool = this;
+	tIndex = index;
+
+	while(true)
+	{
+		Task task;
+		if(pop(index, task))
+		{
+			execute(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(mMutex);
+		mWakeup.wait(lock, [this] {return mStop || mQueued > 0;});
+		if(mStop && mQueued == 0)return;
+	}
+}
+
+/*!
+ \brief Executes tasks until the counter, which is protected by the mutex, reaches 0.
+ */
+void ThreadPool::help(const uint32 &pending)
+{
+	uint32 index = (tPool == this) ? tIndex : 0;
+
+	while(true)
+	{
+		Task task;
+		if(pop(index, task))
+		{
+			execute(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(mMutex);
+		mDone.wait(lock, [this, &pending] {return pending == 0 || mQueued > 0;});
+		if(pending == 0)return;
+	}
+}
+
+void ThreadPool::wait(TaskGroup &group)
+{
+	help(group.mPending);
+}
+
+void ThreadPool::wait()
+{
+	help(mUnfinished);
+}
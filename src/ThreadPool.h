@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ThreadPool.h
+// Application: Shape File Compiler
+// Purpose:     Work-stealing thread pool
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_ThreadPool_h
+#define shpc_ThreadPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/Core.h"
+
+namespace shpc
+{
+
+	class ThreadPool;
+
+	/*!
+	 \brief A group of tasks, for which can be waited together.
+	 */
+	class TaskGroup
+	{
+		public:
+
+			TaskGroup();
+
+		private:
+
+			friend class ThreadPool;
+
+			// Number of tasks of the group, which are not finished yet. Protected by the mutex of the
+			// pool.
+			uint32 mPending;
+	};
+
+	/*!
+	 \brief A pool of worker threads. Each worker has its own task queue. A worker takes new tasks
+	 from the back of its own queue and steals from the front of the other queues, if its own queue
+	 is empty. Tasks submitted by a worker are added to its own queue, all other tasks are
+	 distributed round robin.
+	 */
+	class ThreadPool
+	{
+		public:
+
+			/*!
+			 \brief Constructor
+			 \param threads The number of worker threads. If 0, one thread per core is started.
+			 */
+			ThreadPool(uint32 threads = 0);
+
+			/*!
+			 \brief Destructor. Waits until all tasks are finished and stops the workers.
+			 */
+			~ThreadPool();
+
+			/*!
+			 \brief Returns the number of worker threads.
+			 */
+			uint32 size() const;
+
+			/*!
+			 \brief Adds a task to the pool. Tasks must not throw exceptions.
+			 \param task The task.
+			 \param group The group of the task or nullptr.
+			 */
+			void submit(const std::function<void()> &task, TaskGroup* group = nullptr);
+
+			/*!
+			 \brief Waits until all tasks of the group are finished. The calling thread executes tasks
+			 itself while waiting, so this method may also be called from within a task.
+			 */
+			void wait(TaskGroup &group);
+
+			/*!
+			 \brief Waits until all submitted tasks are finished. Must not be called from within a
+			 task.
+			 */
+			void wait();
+
+		private:
+
+			/*!
+			 \brief A task together with its group.
+			 */
+			struct Task
+			{
+				std::function<void()> function;
+				TaskGroup* group;
+			};
+
+			/*!
+			 \brief Task queue of one worker.
+			 */
+			struct Queue
+			{
+				std::mutex mutex;
+				std::deque<Task> tasks;
+			};
+
+			// The queues of the workers.
+			std::vector<Queue*> mQueues;
+
+			// The worker threads.
+			std::vector<std::thread> mThreads;
+
+			// Protects the counters for sleeping and waking up.
+			std::mutex mMutex;
+
+			// Signals new tasks to the workers.
+			std::condition_variable mWakeup;
+
+			// Signals finished tasks to waiting threads.
+			std::condition_variable mDone;
+
+			// Number of tasks in the queues.
+			std::atomic<uint32> mQueued;
+
+			// Number of tasks which are not finished yet.
+			uint32 mUnfinished;
+
+			// Queue for the next task submitted from outside of the pool.
+			std::atomic<uint32> mNext;
+
+			// Status whether the workers shall stop.
+			bool mStop;
+
+			bool pop(uint32 index, Task &task);
+
+			void execute(Task &task);
+
+			void help(const uint32 &pending);
+
+			void work(uint32 index);
+	};
+
+}
+
+#endif
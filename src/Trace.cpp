@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Trace.cpp
+// Application: Shape File Compiler
+// Purpose:     Timeline of the compilation in the Chrome trace format
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstdio>
+
+#include "AtomicFile.h"
+#include "Trace.h"
+
+using namespace shpc;
+
+/*!
+ \brief Returns a small number for the current thread, which is used as thread id in the trace.
+ */
+static uint32 threadNumber()
+{
+	static std::atomic<uint32> next(1);
+	static thread_local uint32 number = next++;
+	return number;
+}
+
+/*!
+ \brief Appends the text as JSON string.
+ */
+static void appendJson(std::string &out, const std::string &text)
+{
+	out.push_back('"');
+	for(size_t a = 0; a < text.size(); a++)
+	{
+		char c = text[a];
+		if(c == '"' || c == '\\')
+		{
+			out.push_back('\\');
+			out.push_back(c);
+		}
+		else if((uint8)c < 0x20)
+		{
+			char escape[8];
+			std::snprintf(escape, sizeof(escape), "\\u%04x", (uint8)c);
+			out.append(escape);
+		}
+		else out.push_back(c);
+	}
+	out.push_back('"');
+}
+
+Trace::Trace()
+{
+	mStart = std::chrono::steady_clock::now();
+}
+
+int64 Trace::now() const
+{
+	std::chrono::steady_clock::duration time = std::chrono::steady_clock::now() - mStart;
+	return std::chrono::duration_cast<std::chrono::microseconds>(time).count();
+}
+
+void Trace::add(const char* name, const char* category, int64 start, const jm::String &detail)
+{
+	Event event;
+	event.name = name;
+	event.category = category;
+	event.start = start;
+	event.duration = now() - start;
+	event.thread = threadNumber();
+
+	// Details are UTF-8 encoded
+	if(detail.size() > 0)event.detail = detail.toCString().constData();
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	mEvents.push_back(event);
+}
+
+void Trace::save(const jm::String &filename) const
+{
+	std::string out = "{\"traceEvents\":[\n";
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		for(size_t a = 0; a < mEvents.size(); a++)
+		{
+			const Event &event = mEvents[a];
+			char numbers[128];
+			std::snprintf(numbers,
+			              sizeof(numbers),
+			              ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%lld,\"dur\":%lld",
+			              event.thread,
+			              (long long)event.start,
+			              (long long)event.duration);
+
+			out.append("{\"name\":");
+			appendJson(out, event.name);
+			out.append(",\"cat\":");
+			appendJson(out, event.category);
+			out.append(numbers);
+			if(event.detail.size() > 0)
+			{
+				out.append(",\"args\":{\"detail\":");
+				appendJson(out, event.detail);
+				out.append("}");
+			}
+			out.append(a + 1 < mEvents.size() ? "},\n" : "}\n");
+		}
+	}
+	out.append("]}\n");
+
+	saveAtomic(filename, (const uint8*)out.data(), out.size());
+}
+
+TraceSpan::TraceSpan(Trace* trace, const char* name, const char* category, const jm::String &detail)
+{
+	mTrace = trace;
+	mName = name;
+	mCategory = category;
+	if(mTrace != nullptr)
+	{
+		mDetail = detail;
+		mStart = mTrace->now();
+	}
+	else mStart = 0;
+}
+
+TraceSpan::~TraceSpan()
+{
+	if(mTrace != nullptr)mTrace->add(mName, mCategory, mStart, mDetail);
+}
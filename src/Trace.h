@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Trace.h
+// Application: Shape File Compiler
+// Purpose:     Timeline of the compilation in the Chrome trace format
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     16.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_Trace_h
+#define shpc_Trace_h
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/Core.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief The trace records spans of time, e.g. the phases of a compilation, and saves them in the
+	 trace event format of Chrome (chrome://tracing, Perfetto). Spans can be added from several
+	 threads at once.
+	 */
+	class Trace
+	{
+		public:
+
+			Trace();
+
+			/*!
+			 \brief Returns the time in microseconds since the creation of the trace.
+			 */
+			int64 now() const;
+
+			/*!
+			 \brief Adds a span of the current thread.
+			 \param name The name of the span.
+			 \param category The category, e.g. "phase" or "file".
+			 \param start The start in microseconds, see now().
+			 \param detail Optional text, which is shown as argument of the span.
+			 */
+			void add(const char* name,
+			         const char* category,
+			         int64 start,
+			         const jm::String &detail = jm::kEmptyString);
+
+			/*!
+			 \brief Saves all spans as JSON file.
+			 */
+			void save(const jm::String &filename) const;
+
+		private:
+
+			/*!
+			 \brief A recorded span.
+			 */
+			struct Event
+			{
+				const char* name;
+				const char* category;
+				int64 start;
+				int64 duration;
+				uint32 thread;
+				std::string detail;
+			};
+
+			// The time of the creation.
+			std::chrono::steady_clock::time_point mStart;
+
+			// Protects the events.
+			mutable std::mutex mMutex;
+
+			// The recorded spans.
+			std::vector<Event> mEvents;
+	};
+
+	/*!
+	 \brief Records a span from the construction to the destruction of the object. If the trace is
+	 nullptr, nothing is recorded.
+	 */
+	class TraceSpan
+	{
+		public:
+
+			TraceSpan(Trace* trace,
+			          const char* name,
+			          const char* category,
+			          const jm::String &detail = jm::kEmptyString);
+
+			~TraceSpan();
+
+		private:
+
+			Trace* mTrace;
+			const char* mName;
+			const char* mCategory;
+			jm::String mDetail;
+			int64 mStart;
+	};
+
+}
+
+#endif
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Transform.cpp
+// Application: Shape File Compiler
+// Purpose:     Affine transformation of points
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SHPC_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SHPC_NEON
+#endif
+
+#include "Transform.h"
+
+using namespace shpc;
+
+Transform::Transform()
+{
+	mA = 1;
+	mB = 0;
+	mC = 0;
+	mD = 1;
+	mE = 0;
+	mF = 0;
+}
+
+Transform::Transform(float a, float b, float c, float d, float e, float f)
+{
+	mA = a;
+	mB = b;
+	mC = c;
+	mD = d;
+	mE = e;
+	mF = f;
+}
+
+Transform Transform::multiply(const Transform &other) const
+{
+	return Transform(mA * other.mA + mC * other.mB,
+	                 mB * other.mA + mD * other.mB,
+	                 mA * other.mC + mC * other.mD,
+	                 mB * other.mC + mD * other.mD,
+	                 mA * other.mE + mC * other.mF + mE,
+	                 mB * other.mE + mD * other.mF + mF);
+}
+
+void Transform::apply(const Point* in, Point* out, uint32 count) const
+{
+	uint32 a = 0;
+
+#if defined(SHPC_SSE2)
+	// Two points per register: x0 y0 x1 y1
+	const __m128 ab = _mm_setr_ps(mA, mB, mA, mB);
+	const __m128 cd = _mm_setr_ps(mC, mD, mC, mD);
+	const __m128 ef = _mm_setr_ps(mE, mF, mE, mF);
+	for(; a + 2 <= count; a += 2)
+	{
+		__m128 points = _mm_loadu_ps(&in[a].x);
+		__m128 x = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 2, 0, 0));
+		__m128 y = _mm_shuffle_ps(points, points, _MM_SHUFFLE(3, 3, 1, 1));
+		__m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, ab), _mm_mul_ps(y, cd)), ef);
+		_mm_storeu_ps(&out[a].x, result);
+	}
+#elif defined(SHPC_NEON)
+	// Four points per register pair, split into x and y
+	for(; a + 4 <= count; a += 4)
+	{
+		float32x4x2_t points = vld2q_f32(&in[a].x);
+		float32x4x2_t result;
+		result.val[0] = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(mE), points.val[0], mA),
+		                            points.val[1],
+		                            mC);
+		result.val[1] = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(mF), points.val[0], mB),
+		                            points.val[1],
+		                            mD);
+		vst2q_f32(&out[a].x, result);
+	}
+#endif
+
+	for(; a < count; a++)out[a] = map(in[a].x, in[a].y);
+}
+
+Transform Transform::translation(float dx, float dy)
+{
+	return Transform(1, 0, 0, 1, dx, dy);
+}
+
+Transform Transform::rotation(double degrees)
+{
+	double radians = degrees * 3.14159265358979323846 / 180;
+	float c = (float)std::cos(radians);
+	float s = (float)std::sin(radians);
+	return Transform(c, s, -s, c, 0, 0);
+}
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Transform.h
+// Application: Shape File Compiler
+// Purpose:     Affine transformation of points
+//
+// Author:      Uwe Runtemund (2013-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef shpc_Transform_h
+#define shpc_Transform_h
+
+#include "core/Core.h"
+
+#include "Outline.h"
+
+namespace shpc
+{
+
+	/*!
+	 \brief An affine transformation of points: x' = a * x + c * y + e and y' = b * x + d * y + f.
+	 Arrays of points are transformed by SSE2 or NEON kernels, if the target supports them.
+	 */
+	class Transform
+	{
+		public:
+
+			/*!
+			 \brief Creates the identity.
+			 */
+			Transform();
+
+			Transform(float a, float b, float c, float d, float e, float f);
+
+			/*!
+			 \brief Returns the transformation, which first applies the other and then this
+			 transformation.
+			 */
+			Transform multiply(const Transform &other) const;
+
+			/*!
+			 \brief Returns the transformed point.
+			 */
+			Point map(float x, float y) const
+			{
+				return {mA * x + mC * y + mE, mB * x + mD * y + mF};
+			}
+
+			/*!
+			 \brief Transforms the points. Input and output may be the same array.
+			 */
+			void apply(const Point* in, Point* out, uint32 count) const;
+
+			/*!
+			 \brief Returns a translation.
+			 */
+			static Transform translation(float dx, float dy);
+
+			/*!
+			 \brief Returns a counterclockwise rotation by the angle in degrees.
+			 */
+			static Transform rotation(double degrees);
+
+		private:
+
+			float mA;
+			float mB;
+			float mC;
+			float mD;
+			float mE;
+			float mF;
+	};
+
+}
+
+#endif